@@ -0,0 +1,41 @@
+#include "Affine2D.h"
+#include <cmath>
+
+Affine2D Affine2D::rotation(float angle) {
+    float radian = angle * (3.1415926f / 180.0f);
+    float cs = std::cos(radian);
+    float sn = std::sin(radian);
+    return { cs, sn, -sn, cs, 0.0f, 0.0f };
+}
+
+Affine2D Affine2D::fromTransform(float x, float y, float angle, float scale) {
+    float radian = angle * (3.1415926f / 180.0f);
+    float cs = std::cos(radian) * scale;
+    float sn = std::sin(radian) * scale;
+    return { cs, sn, -sn, cs, x, y };
+}
+
+Affine2D Affine2D::inverse() const {
+    float det = a * d - b * c;
+    if (det == 0.0f) {
+        return identity();
+    }
+    float ia = d / det, ib = -b / det, ic = -c / det, id = a / det;
+    return { ia, ib, ic, id, -(ia * tx + ic * ty), -(ib * tx + id * ty) };
+}
+
+void Affine2D::transformPoints(const float* in, float* out, size_t count) const {
+    for (size_t i = 0; i < count; i++) {
+        float x = in[2 * i];
+        float y = in[2 * i + 1];
+        out[2 * i] = a * x + c * y + tx;
+        out[2 * i + 1] = b * x + d * y + ty;
+    }
+}
+
+float Affine2D::getMaxScale() const {
+    // Largest singular value of [[a, c], [b, d]]
+    float p = a * a + b * b + c * c + d * d;
+    float q = a * d - b * c;
+    return std::sqrt(0.5f * (p + std::sqrt(std::fmax(0.0f, p * p - 4.0f * q * q))));
+}
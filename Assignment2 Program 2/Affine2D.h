@@ -0,0 +1,123 @@
+#ifndef AFFINE2D_H
+#define AFFINE2D_H
+
+#include <cstddef>
+
+/**
+ * @struct Affine2D
+ * @brief Compact 2D affine transformation stored as a 3x2 matrix.
+ *
+ * A point (x, y) maps to (a*x + c*y + tx, b*x + d*y + ty), i.e. the columns (a, b) and (c, d) are
+ * the images of the X and Y axes and (tx, ty) is the translation. Composition follows the OpenGL
+ * convention: (A * B) applied to a point applies B first, so a chain of translate/rotate/scale
+ * calls builds the same matrix as glTranslatef/glRotatef/glScalef would.
+ *
+ * @author Harrison Grenier
+ */
+struct Affine2D {
+    float a;  /**< X-axis image, x component */
+    float b;  /**< X-axis image, y component */
+    float c;  /**< Y-axis image, x component */
+    float d;  /**< Y-axis image, y component */
+    float tx; /**< Translation along X */
+    float ty; /**< Translation along Y */
+
+    /**
+     * @brief Returns the identity transformation.
+     *
+     * @return The identity matrix.
+     */
+    static Affine2D identity() { return { 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f }; }
+
+    /**
+     * @brief Returns a translation.
+     *
+     * @param x Translation along X.
+     * @param y Translation along Y.
+     * @return The translation matrix.
+     */
+    static Affine2D translation(float x, float y) { return { 1.0f, 0.0f, 0.0f, 1.0f, x, y }; }
+
+    /**
+     * @brief Returns a rotation about the origin.
+     *
+     * @param angle Rotation angle in degrees (counterclockwise).
+     * @return The rotation matrix.
+     */
+    static Affine2D rotation(float angle);
+
+    /**
+     * @brief Returns a scale about the origin.
+     *
+     * @param sx Scale factor along X.
+     * @param sy Scale factor along Y.
+     * @return The scale matrix.
+     */
+    static Affine2D scaling(float sx, float sy) { return { sx, 0.0f, 0.0f, sy, 0.0f, 0.0f }; }
+
+    /**
+     * @brief Returns translation(x, y) * rotation(angle) * scaling(scale, scale) in one step.
+     *
+     * This is the transformation of a GraphicObject2D; sin and cos are evaluated only once.
+     *
+     * @param x Translation along X.
+     * @param y Translation along Y.
+     * @param angle Rotation angle in degrees.
+     * @param scale Uniform scale factor.
+     * @return The combined matrix.
+     */
+    static Affine2D fromTransform(float x, float y, float angle, float scale);
+
+    /**
+     * @brief Composes two transformations; the right-hand one is applied first.
+     *
+     * @param o The transformation applied before this one.
+     * @return The combined matrix.
+     */
+    Affine2D operator*(const Affine2D& o) const {
+        return { a * o.a + c * o.b, b * o.a + d * o.b,
+                 a * o.c + c * o.d, b * o.c + d * o.d,
+                 a * o.tx + c * o.ty + tx, b * o.tx + d * o.ty + ty };
+    }
+
+    /**
+     * @brief Returns the inverse transformation.
+     *
+     * @return The inverse matrix, or the identity if this one is singular.
+     */
+    Affine2D inverse() const;
+
+    /**
+     * @brief Transforms a single point.
+     *
+     * @param x X-coordinate of the point.
+     * @param y Y-coordinate of the point.
+     * @param outX Receives the transformed X-coordinate.
+     * @param outY Receives the transformed Y-coordinate.
+     */
+    void apply(float x, float y, float& outX, float& outY) const {
+        outX = a * x + c * y + tx;
+        outY = b * x + d * y + ty;
+    }
+
+    /**
+     * @brief Transforms a batch of points stored as interleaved x, y pairs.
+     *
+     * The loop has no dependencies between points so the compiler can vectorize it.
+     * in and out may be the same array.
+     *
+     * @param in Source points (2 * count floats).
+     * @param out Destination points (2 * count floats).
+     * @param count Number of points.
+     */
+    void transformPoints(const float* in, float* out, size_t count) const;
+
+    /**
+     * @brief Gets the largest factor by which this transformation stretches a length.
+     *
+     * @return The larger singular value of the linear part.
+     */
+    float getMaxScale() const;
+};
+
+#endif // AFFINE2D_H
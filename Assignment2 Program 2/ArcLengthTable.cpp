@@ -0,0 +1,86 @@
+#include "ArcLengthTable.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // 5-point Gauss-Legendre nodes and weights on [-1, 1]
+    const double GAUSS_NODES[5] = { -0.9061798459386640, -0.5384693101056831, 0.0, 0.5384693101056831, 0.9061798459386640 };
+    const double GAUSS_WEIGHTS[5] = { 0.2369268850561891, 0.4786286704993665, 0.5688888888888889, 0.4786286704993665, 0.2369268850561891 };
+
+    double speed(const std::function<double(double)>& slope, double x) {
+        double s = slope(x);
+        return std::sqrt(1.0 + s * s);
+    }
+}
+
+ArcLengthTable::ArcLengthTable(double start, double end, int intervals, const std::function<double(double)>& slope)
+    : start_(start), step_((end - start) / std::max(intervals, 1)) {
+    int count = std::max(intervals, 1);
+    distance_.reserve(count + 1);
+    rate_.reserve(count + 1);
+
+    distance_.push_back(0.0);
+    rate_.push_back(speed(slope, start));
+    for (int i = 0; i < count; i++) {
+        double a = start + i * step_;
+        double mid = a + 0.5 * step_;
+        double length = 0.0;
+        for (int k = 0; k < 5; k++) {
+            length += GAUSS_WEIGHTS[k] * speed(slope, mid + 0.5 * step_ * GAUSS_NODES[k]);
+        }
+        distance_.push_back(distance_.back() + 0.5 * step_ * length);
+        rate_.push_back(speed(slope, a + step_));
+    }
+
+    // One bucket per step, evenly spaced in distance, holding the step its start distance falls in
+    bucketWidth_ = getLength() / count;
+    bucketStep_.reserve(count);
+    size_t step = 0;
+    for (int i = 0; i < count; i++) {
+        while (step + 1 < static_cast<size_t>(count) && distance_[step + 1] <= i * bucketWidth_) {
+            step++;
+        }
+        bucketStep_.push_back(static_cast<uint32_t>(step));
+    }
+}
+
+double ArcLengthTable::interpolate(size_t step, double t, double& rate) const {
+    // Cubic Hermite basis with the end tangents scaled to the step width
+    double s0 = distance_[step], s1 = distance_[step + 1];
+    double m0 = rate_[step] * step_, m1 = rate_[step + 1] * step_;
+    double t2 = t * t, t3 = t2 * t;
+
+    rate = ((6.0 * t2 - 6.0 * t) * s0 + (3.0 * t2 - 4.0 * t + 1.0) * m0
+        + (6.0 * t - 6.0 * t2) * s1 + (3.0 * t2 - 2.0 * t) * m1) / step_;
+    return (2.0 * t3 - 3.0 * t2 + 1.0) * s0 + (t3 - 2.0 * t2 + t) * m0
+        + (3.0 * t2 - 2.0 * t3) * s1 + (t3 - t2) * m1;
+}
+
+double ArcLengthTable::distanceAt(double x) const {
+    size_t last = distance_.size() - 1;
+    double u = std::min(std::max((x - start_) / step_, 0.0), static_cast<double>(last));
+    size_t step = std::min(static_cast<size_t>(u), last - 1);
+
+    double rate;
+    return interpolate(step, u - step, rate);
+}
+
+double ArcLengthTable::xAt(double distance) const {
+    distance = std::min(std::max(distance, 0.0), getLength());
+
+    // Start from the step the distance's bucket begins in. A bucket is as long as the average step and
+    // no step is shorter than its width in x, so only a few steps are walked to the one containing the distance
+    size_t last = distance_.size() - 2;
+    size_t step = bucketStep_[std::min(static_cast<size_t>(distance / bucketWidth_), bucketStep_.size() - 1)];
+    while (step < last && distance_[step + 1] <= distance) {
+        step++;
+    }
+
+    // One Newton step on the cubic from the linear estimate: the curve is nearly linear over a step,
+    // so this is already within 1e-9 of the exact point, far below float precision
+    double t = (distance - distance_[step]) / (distance_[step + 1] - distance_[step]);
+    double rate;
+    double error = interpolate(step, t, rate) - distance;
+    t = std::min(std::max(t - error / (rate * step_), 0.0), 1.0);
+    return start_ + (step + t) * step_;
+}
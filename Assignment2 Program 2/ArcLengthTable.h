@@ -0,0 +1,107 @@
+#ifndef ARCLENGTHTABLE_H
+#define ARCLENGTHTABLE_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * @class ArcLengthTable
+ * @brief Arc length of a curve y = f(x) over an interval, with lookups in both directions.
+ *
+ * The interval is split into equal steps in x. For each step the length is integrated once, when the
+ * table is built, with 5-point Gauss-Legendre quadrature of sqrt(1 + f'(x)^2); the running total and
+ * the rate ds/dx are stored at every step boundary. Between boundaries the distance is the cubic
+ * Hermite curve through those values, which is accurate to far below float precision.
+ *
+ * Both lookups are O(1): distanceAt() finds the step directly from x, and xAt() starts from a
+ * second index, evenly spaced in distance, and walks at most a few steps to the one containing the
+ * distance before solving the cubic with Newton's method. No curve function is called after
+ * construction.
+ *
+ * @author Harrison Grenier
+ */
+class ArcLengthTable {
+public:
+    /**
+     * @brief Integrates the arc length of a curve.
+     *
+     * @param start First x of the interval.
+     * @param end Last x of the interval; must be greater than start.
+     * @param intervals Number of equal steps the interval is split into.
+     * @param slope Derivative f'(x) of the curve.
+     */
+    ArcLengthTable(double start, double end, int intervals, const std::function<double(double)>& slope);
+
+    /**
+     * @brief Gets the length of the whole curve.
+     *
+     * @return Arc length from start to end.
+     */
+    double getLength() const { return distance_.back(); }
+
+    /**
+     * @brief Gets the distance along the curve from start to a point.
+     *
+     * @param x X-coordinate of the point, clamped to the interval.
+     * @return Arc length from start to x.
+     */
+    double distanceAt(double x) const;
+
+    /**
+     * @brief Gets the point at a distance along the curve; the inverse of distanceAt().
+     *
+     * @param distance Arc length from start, clamped to [0, getLength()].
+     * @return X-coordinate of the point.
+     */
+    double xAt(double distance) const;
+
+private:
+    /**
+     * @brief Evaluates the Hermite distance curve within one step.
+     *
+     * @param step Index of the step.
+     * @param t Position within the step, from 0 to 1.
+     * @param rate Receives ds/dx at that position.
+     * @return Arc length from start.
+     */
+    double interpolate(size_t step, double t, double& rate) const;
+
+    /**
+     * @var start_
+     * @brief First x of the interval.
+     */
+    double start_;
+
+    /**
+     * @var step_
+     * @brief Width of one step in x.
+     */
+    double step_;
+
+    /**
+     * @var distance_
+     * @brief Arc length from start to every step boundary.
+     */
+    std::vector<double> distance_;
+
+    /**
+     * @var rate_
+     * @brief Rate ds/dx = sqrt(1 + f'(x)^2) at every step boundary.
+     */
+    std::vector<double> rate_;
+
+    /**
+     * @var bucketWidth_
+     * @brief Distance covered by one entry of bucketStep_.
+     */
+    double bucketWidth_;
+
+    /**
+     * @var bucketStep_
+     * @brief Step containing the start of every distance bucket.
+     */
+    std::vector<uint32_t> bucketStep_;
+};
+
+#endif // ARCLENGTHTABLE_H
@@ -13,10 +13,18 @@
 #include <memory>
 #include <iostream>
 #include <cmath>
+#include <chrono>
 //
 #include "glPlatform.h"
 #include "Cart.h"
 #include "Road.h"
+#include "Traffic.h"
+#include "GLRenderContext.h"
+#include "SoftwareRasterizer.h"
+#include "FixedTimestep.h"
+#include "SceneFile.h"
+#include "InputRecorder.h"
+#include "BenchmarkStats.h"
 
 
 
@@ -26,8 +34,20 @@ using namespace std;
 void myDisplay(void);
 void myResize(int w, int h);
 void myInit(void);
-void myTimerFunc(int value);
+void myIdleFunc(void);
+void updateIdleFunc(void);
 void handleKeyboard(unsigned char c, int x, int y);
+void onKeyboard(unsigned char key, int x, int y);
+void onResize(int w, int h);
+void replayResize(int w, int h);
+void runTicks(int ticks);
+void finishReplay(void);
+void cycleCollisions(void);
+void resetTraffic(void);
+void setMainCartSpeed(void);
+int renderOffline(int frames, const char* outputPattern);
+bool saveScene(const string& path);
+bool loadScene(const string& path);
 
 // inital window perams
 const int   INIT_WIN_X = 100,
@@ -45,19 +65,56 @@ float cartSpeed = 0.05f;   // Initial speed of the cart
 bool cartMoving = false;   // Flag to check if the cart is moving
 int cartDirection = 1;     // 1 for moving right, -1 for moving left
 
+// time covered by one simulation tick; the cart moves cartSpeed per tick
+const float TICK_SECONDS = 0.016f;
+
+// turns measured real time into whole ticks, independently of the frame rate
+FixedTimestep simulationClock(TICK_SECONDS);
+
 
 // Create a road object of type 1 (sine wave)
 Road road(1);
 
+// every cart on the road, stepped, collided and drawn together: the road's own cart is cart 0,
+// the ones added with 't' follow
+Traffic traffic(road.getShape());
+
+// Immediate-mode OpenGL backend the scene is drawn into
+GLRenderContext glContext;
+
+// scene file written by 'S' and read by 'L', set with --scene (which also loads it at startup)
+string scenePath = "road.a2s";
+
+// records the session's input with --record, or plays a recorded session back with --replay
+InputRecorder inputRecorder;
+
+// handlers recorded events are played back through (the road has no mouse input)
+const InputHandlers replayHandlers = { handleKeyboard, nullptr, nullptr, replayResize, runTicks };
+
+// frame timings of a replay, printed when it ends
+BenchmarkStats replayStats;
+
 void myDisplay(void) {
+	if (inputRecorder.isReplaying()) {
+		replayStats.beginFrame();
+	}
+
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
 
-	road.draw();    // Draw the road
-	road.drawCart(); // Draw the cart using the road's method
+	road.draw(glContext);    // Draw the road
+
+	// Draw the carts where they are at this moment, between the last two simulation ticks
+	// (a replay always shows whole ticks, so its frames don't depend on the machine's speed)
+	bool blend = cartMoving && !inputRecorder.isReplaying();
+	traffic.draw(glContext, blend ? simulationClock.getAlpha() : 1.0f);
 
 	glutSwapBuffers();
+
+	if (inputRecorder.isReplaying()) {
+		replayStats.endFrame();
+	}
 }
 
 
@@ -73,12 +130,15 @@ void myResize(int w, int h) {
 	float aspectRatio = (float)w / (float)h;
 
 	// Adjust the projection to cover the area where the road and cart are drawn
+	BoundingBox2D view;
 	if (aspectRatio > 1.0f) { // Wider than tall
-		gluOrtho2D(0, 40 * aspectRatio, 0, 40);
+		view = { 0, 0, 40 * aspectRatio, 40 };
 	}
 	else { // Taller than wide
-		gluOrtho2D(0, 40, 0, 40 / aspectRatio);
+		view = { 0, 0, 40, 40 / aspectRatio };
 	}
+	gluOrtho2D(view.minX, view.maxX, view.minY, view.maxY);
+	glContext.setViewBounds(view);  // lets the cart be skipped once it leaves the window
 
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity(); // Reset the model view matrix after changing projection
@@ -87,35 +147,239 @@ void myResize(int w, int h) {
 	glutPostRedisplay();
 }
 
-void myTimerFunc(int value) {
-	if (cartMoving) {
-		road.moveCart(cartSpeed);  // Move the cart via the road object
+// Called whenever GLUT has no events to handle: catch the simulation up with real time, then redraw.
+// Slow frames run several ticks, fast frames none, so the cart always drives at the same speed
+// During a replay the recorded events, tick counts included, take the place of input and real time
+void myIdleFunc(void) {
+	if (inputRecorder.isReplaying()) {
+		inputRecorder.replay(replayHandlers);
+		if (!inputRecorder.isReplaying()) {
+			finishReplay();
+		}
+	}
+	else if (cartMoving) {
+		int ticks = simulationClock.advance();
+		inputRecorder.recordTicks(ticks);
+		runTicks(ticks);
 	}
 
-	glutTimerFunc(16, myTimerFunc, 0);
 	glutPostRedisplay();
 }
+
+// Runs the idle loop only while something moves: a paused window would otherwise redraw as fast as
+// it can, so it only redraws when input or a resize asks it to
+void updateIdleFunc(void) {
+	glutIdleFunc(cartMoving || inputRecorder.isReplaying() ? myIdleFunc : nullptr);
+}
+
+// Advances the simulation by a number of ticks
+void runTicks(int ticks) {
+	static ThreadPool steppers;  // created on first use, one thread per core
+	for (int i = 0; i < ticks; i++) {
+		traffic.capture();
+		traffic.step(steppers);  // Move every cart, the road's included, so none passes through another
+		if (road.getCart()) {
+			road.setCartState(traffic.getDistance(0), traffic.getDirection(0), traffic.getWheelAngle(0));
+		}
+	}
+}
+
+// GLUT input callbacks: record the event, then handle it. Live keys other than Escape are ignored
+// during a replay; resizes aren't, since the window has to follow them anyway
+void onKeyboard(unsigned char key, int x, int y) {
+	if (inputRecorder.isReplaying() && key != 27) {
+		return;
+	}
+	inputRecorder.recordKeyboard(key, x, y);
+	handleKeyboard(key, x, y);
+}
+
+void onResize(int w, int h) {
+	inputRecorder.recordResize(w, h);
+	myResize(w, h);
+}
+
+// Gives the window its recorded size, with the projection set right away
+void replayResize(int w, int h) {
+	glutReshapeWindow(w, h);
+	myResize(w, h);
+}
+
+// Prints the frame timings of the replay that just ended and quits
+void finishReplay(void) {
+	replayStats.print(cout, traffic.size() + 1, "objects");  // the road and every cart, its own being cart 0
+	exit(0);
+}
+
 // check for user keyboard inputs
 void handleKeyboard(unsigned char key, int x, int y) {
 	switch (key) {
 	case 27: exit(0); break;    // Escape key
-	case ' ': cartMoving = !cartMoving; break; // Toggle cart movement
-	case ',': if (cartSpeed > 0.01f) cartSpeed -= 0.01f; break;  // Decrease speed
-	case '.': if(cartSpeed < 0.35f)cartSpeed += 0.01f; break;  // Increase speed
+	case ' ': // Toggle cart movement
+		cartMoving = !cartMoving;
+		traffic.capture();        // show the current state until the next tick
+		simulationClock.reset();  // time spent paused doesn't count
+		updateIdleFunc();
+		break;
+	case ',': if (cartSpeed > 0.01f) cartSpeed -= 0.01f; setMainCartSpeed(); break;  // Decrease speed
+	case '.': if(cartSpeed < 0.35f)cartSpeed += 0.01f; setMainCartSpeed(); break;  // Increase speed
+	case 't': traffic.addCart(0.0, cartSpeed); break;  // Add a cart at the left end, at the current speed
+	case 'c': cycleCollisions(); break;  // Change how the added carts collide
+	case 'S': saveScene(scenePath); break;  // Save the road and cart
+	case 'L': loadScene(scenePath); break;  // Restore the road and cart
 	}
 	glutPostRedisplay();
 }
 
 
+// Steps the added carts' collision response through none, stop, bounce and follow
+void cycleCollisions(void) {
+	const char* names[] = { "none", "stop", "bounce", "follow" };
+	int next = (static_cast<int>(traffic.getCollisionResponse()) + 1) % 4;
+	traffic.setCollisionResponse(static_cast<CollisionResponse>(next));
+	cout << "collisions: " << names[next] << endl;
+}
+
+// Writes the road type and the cart's placement, direction and wheel angle
+bool saveScene(const string& path) {
+	vector<RoadRecord> roads = { road.toRecord() };
+	if (!SceneFile::write(path, { SceneFile::section(SceneSectionType::ROADS, roads) })) {
+		cerr << "could not write " << path << endl;
+		return false;
+	}
+	cout << "saved the road to " << path << endl;
+	return true;
+}
+
+// Restores the first road of a scene file; the traffic starts over from the restored cart
+bool loadScene(const string& path) {
+	SceneFile file;
+	if (!file.open(path)) {
+		cerr << file.getError() << endl;
+		return false;
+	}
+	size_t count;
+	const RoadRecord* roads = file.getSection<RoadRecord>(SceneSectionType::ROADS, count);
+	if (count == 0) {
+		cerr << path << " has no road" << endl;
+		return false;
+	}
+
+	road.restore(roads[0]);
+	resetTraffic();  // the added carts aren't saved, and may be on another road now
+	return true;
+}
+
+// Starts the traffic over with only the road's cart, which keeps its place, direction and wheels
+void resetTraffic(void) {
+	CollisionResponse collisions = traffic.getCollisionResponse();
+	traffic = Traffic(road.getShape());
+	if (road.getCart()) {
+		RoadRecord cart = road.toRecord();
+		traffic.addCart(cart.cartDistance, cartSpeed, cart.cartDirection < 0);
+		traffic.setWheelAngle(0, cart.cartWheelAngle);
+	}
+	traffic.setCollisionResponse(collisions);
+}
+
+// Gives the road's cart the speed set with ',' and '.'
+void setMainCartSpeed(void) {
+	if (road.getCart()) {
+		traffic.setSpeed(0, cartSpeed);
+	}
+}
+
+
 void myInit(void)
 {
 
 	myDisplay();
 }
 
+// Render the moving cart with the software rasterizer, without a window or GPU
+int renderOffline(int frames, const char* outputPattern) {
+	// The pattern is checked before any frame is drawn rather than handed to printf
+	string path;
+	if (outputPattern != nullptr && !SoftwareRasterizer::formatFramePath(outputPattern, 0, path)) {
+		cerr << "the output pattern needs exactly one %d, e.g. frame_%04d.png: " << outputPattern << endl;
+		return 1;
+	}
+
+	SoftwareRasterizer rasterizer(winWidth, winHeight, X_MIN, X_MAX, Y_MIN, Y_MAX);
+	auto start = chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++) {
+		rasterizer.beginFrame();
+		road.draw(rasterizer);
+		road.drawCart(rasterizer);
+		rasterizer.endFrame();
+		road.moveCart(cartSpeed);
+
+		if (outputPattern != nullptr) {
+			SoftwareRasterizer::formatFramePath(outputPattern, frame, path);
+			if (!rasterizer.writeImage(path)) {
+				cerr << "could not write " << path << endl;
+				return 1;
+			}
+		}
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	cout << frames << " frames in " << seconds << " s";
+	if (frames > 0 && seconds > 0.0) {
+		cout << " (" << frames / seconds << " fps)";
+	}
+	cout << " on " << rasterizer.getThreadCount() << " threads" << endl;
+	return 0;
+}
+
 int main(int argc, char** argv) {
 	
 	road.createCart(0.0f, road.getY(0.0f), 0.0f, 1.0f);
+	resetTraffic();
+
+	// Leading options: Assignment2 [--scene <file>] [--record <log> | --replay <log> [--fast]] [...]
+	string recordPath, replayPath;
+	bool replayFast = false;
+	while (argc >= 2) {
+		string option = argv[1];
+		int used;
+		if (option == "--fast") {
+			replayFast = true;
+			used = 1;
+		}
+		else if (argc >= 3 && (option == "--scene" || option == "--record" || option == "--replay")) {
+			if (option == "--scene") {
+				scenePath = argv[2];
+				loadScene(scenePath);
+			}
+			else {
+				(option == "--record" ? recordPath : replayPath) = argv[2];
+			}
+			used = 2;
+		}
+		else {
+			break;
+		}
+		argv[used] = argv[0];
+		argc -= used;
+		argv += used;
+	}
+
+	// Headless mode: Assignment2 [--scene <file>] --offline <frames> [output pattern, e.g. frame_%04d.png]
+	if (argc >= 3 && string(argv[1]) == "--offline") {
+		return renderOffline(atoi(argv[2]), argc >= 4 ? argv[3] : nullptr);
+	}
+
+	// The log has to be valid before a window is opened for it
+	if (!replayPath.empty() && !inputRecorder.loadReplay(replayPath, replayFast)) {
+		cerr << inputRecorder.getError() << endl;
+		return 1;
+	}
+	if (!recordPath.empty() && !inputRecorder.startRecording(recordPath)) {
+		cerr << "could not create " << recordPath << endl;
+		return 1;
+	}
+
 	// Initialize OpenGL and GLUT as before
 	glutInit(&argc, argv);
 	glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA);
@@ -125,9 +389,9 @@ int main(int argc, char** argv) {
 
 	// Set up display and other callback functions
 	glutDisplayFunc(myDisplay);
-	glutReshapeFunc(myResize);
-	glutTimerFunc(100, myTimerFunc, 0);  // Start the animation loop with a timer
-	glutKeyboardFunc(handleKeyboard);
+	glutReshapeFunc(onResize);
+	updateIdleFunc();  // Drive the animation loop from real elapsed time, or from a replayed log
+	glutKeyboardFunc(onKeyboard);
 
 	myInit(); // Initialize any OpenGL settings
 	glutMainLoop(); // Enter the main event-processing loop
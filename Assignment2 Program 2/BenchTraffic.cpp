@@ -0,0 +1,211 @@
+// Headless stress benchmark for the carts: puts many carts on the two road shapes, steps them with
+// Road::moveCart (or, with --traffic, as Traffic on one road per shape) for a fixed number of frames
+// without a window and reports frame-time statistics.
+//
+// usage: bench_traffic [--carts M] [--frames F] [--warmup W] [--threads T] [--size WxH] [--target raster|null|record] [--traffic]
+//                      [--collisions none|stop|bounce|follow] [--output PATTERN]
+
+#include "Road.h"
+#include "Traffic.h"
+#include "SoftwareRasterizer.h"
+#include "NullRenderContext.h"
+#include "RecordingRenderContext.h"
+#include "BenchmarkStats.h"
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Same world rectangle and cart speed as the interactive program
+const float X_MAX = 40.0f, X_MIN = 0.0f,
+Y_MAX = 40.0f, Y_MIN = 0.0f;
+const float cartSpeed = 0.05f;
+
+static void printUsage() {
+	cerr << "usage: bench_traffic [--carts M] [--frames F] [--warmup W] [--threads T] [--size WxH] "
+		"[--target raster|null|record] [--traffic] [--collisions none|stop|bounce|follow] [--output PATTERN]\n"
+		"  --carts M    carts, split between both road types (default 1000)\n"
+		"  --frames F   measured frames (default 300)\n"
+		"  --warmup W   unmeasured frames run first (default 10)\n"
+		"  --threads T  rasterizer threads, 0 = one per core (default 0)\n"
+		"  --size WxH   image size in pixels (default 600x600)\n"
+		"  --target     raster draws into the software rasterizer, null only walks the scene,\n"
+		"               record captures each frame's draw calls and times replaying them into the\n"
+		"               null and raster targets separately\n"
+		"  --traffic    keep the carts of each shape in one Traffic, stepped in parallel and drawn in bulk\n"
+		"  --collisions how the carts of a Traffic respond to running into each other (default none)\n"
+		"  --output     write every measured frame of the raster or record target to an image file,\n"
+		"               named by a pattern with one %d, e.g. frame_%04d.png or frame_%04d.ppm; not timed\n";
+}
+
+// Maps the name given to --collisions onto a response; false if there is no such response
+static bool parseCollisionResponse(const string& name, CollisionResponse& response) {
+	const pair<const char*, CollisionResponse> names[] = { { "none", CollisionResponse::NONE }, { "stop", CollisionResponse::STOP },
+		{ "bounce", CollisionResponse::BOUNCE }, { "follow", CollisionResponse::FOLLOW } };
+	for (const auto& entry : names) {
+		if (name == entry.first) {
+			response = entry.second;
+			return true;
+		}
+	}
+	return false;
+}
+
+int main(int argc, char** argv) {
+	int cartCount = 1000, frames = 300, warmup = 10, width = 600, height = 600;
+	unsigned int threads = 0;
+	string target = "raster";
+	bool useTraffic = false;
+	string collisions = "none", outputPattern;
+
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--carts" && hasValue) cartCount = atoi(argv[++i]);
+		else if (arg == "--frames" && hasValue) frames = atoi(argv[++i]);
+		else if (arg == "--warmup" && hasValue) warmup = atoi(argv[++i]);
+		else if (arg == "--threads" && hasValue) threads = static_cast<unsigned int>(atoi(argv[++i]));
+		else if (arg == "--size" && hasValue && sscanf(argv[++i], "%dx%d", &width, &height) == 2) {}
+		else if (arg == "--target" && hasValue) target = argv[++i];
+		else if (arg == "--traffic") useTraffic = true;
+		else if (arg == "--collisions" && hasValue) collisions = argv[++i];
+		else if (arg == "--output" && hasValue) outputPattern = argv[++i];
+		else {
+			printUsage();
+			return 1;
+		}
+	}
+	CollisionResponse response;
+	string outputPath;
+	if (cartCount < 1 || frames < 1 || warmup < 0 || width < 1 || height < 1 ||
+		(target != "raster" && target != "null" && target != "record") || !parseCollisionResponse(collisions, response) ||
+		(!outputPattern.empty() && ((target != "raster" && target != "record") ||
+		!SoftwareRasterizer::formatFramePath(outputPattern, 0, outputPath)))) {
+		printUsage();
+		return 1;
+	}
+
+	// A Road drives a single cart, so every cart gets its own road of alternating type,
+	// with the starting points spread evenly along the world. With --traffic the carts of each
+	// type share one Traffic instead, starting at the same points.
+	vector<Road> roads;
+	Traffic traffic[] = { Traffic(RoadShape::forType(1)), Traffic(RoadShape::forType(2)) };
+	if (!useTraffic) {
+		roads.reserve(cartCount);
+	}
+	for (int i = 0; i < cartCount; i++) {
+		float x = X_MIN + (X_MAX - X_MIN) * (i + 0.5f) / cartCount;
+		if (useTraffic) {
+			Traffic& lane = traffic[i % 2];
+			lane.addCart(lane.getShape().getArcLength().distanceAt(x), cartSpeed);
+		}
+		else {
+			roads.emplace_back(1 + i % 2);
+			roads.back().createCart(x, roads.back().getY(x), 0.0f, 1.0f);
+		}
+	}
+	for (Traffic& lane : traffic) {
+		lane.setCollisionResponse(response);
+	}
+	ThreadPool stepPool(useTraffic ? threads : 1);
+	// The curves themselves only need drawing once per road type
+	Road curves[] = { Road(1), Road(2) };
+
+	SoftwareRasterizer rasterizer(width, height, X_MIN, X_MAX, Y_MIN, Y_MAX, threads);
+	NullRenderContext nullContext;
+	nullContext.setPixelsPerUnit(rasterizer.getPixelsPerUnit());
+	nullContext.setViewBounds(rasterizer.getViewBounds());
+	RecordingRenderContext recorder;
+	recorder.setPixelsPerUnit(rasterizer.getPixelsPerUnit());
+	recorder.setViewBounds(rasterizer.getViewBounds());
+	bool raster = target == "raster";
+	bool record = target == "record";
+	RenderContext& context = raster ? static_cast<RenderContext&>(rasterizer)
+		: record ? static_cast<RenderContext&>(recorder) : nullContext;
+
+	cout << "scene:         " << cartCount << " carts on 2 road types"
+		<< (useTraffic ? ", as traffic with collisions " + collisions : "") << "\n"
+		<< "target:        " << target << " " << width << "x" << height << ", "
+		<< (raster || record ? rasterizer.getThreadCount() : 1) << " threads" << endl;
+
+	BenchmarkStats stats, nullReplayStats, rasterReplayStats;
+	for (int frame = 0; frame < warmup + frames; frame++) {
+		if (frame >= warmup) {
+			stats.beginFrame();
+		}
+		if (raster) {
+			rasterizer.beginFrame();
+		}
+		if (record) {
+			recorder.clear();
+		}
+		for (const Road& curve : curves) {
+			curve.draw(context);
+		}
+		for (const Road& road : roads) {
+			road.drawCart(context);
+		}
+		for (const Traffic& lane : traffic) {
+			lane.draw(context);
+		}
+		if (raster) {
+			rasterizer.endFrame();
+		}
+		for (Road& road : roads) {
+			road.moveCart(cartSpeed);
+		}
+		for (Traffic& lane : traffic) {
+			lane.step(stepPool);
+		}
+		if (frame >= warmup) {
+			stats.endFrame();
+		}
+
+		// The captured frame, drawn again without walking the scene
+		if (record) {
+			bool measured = frame >= warmup;
+			if (measured) {
+				nullReplayStats.beginFrame();
+			}
+			recorder.replay(nullContext);
+			if (measured) {
+				nullReplayStats.endFrame();
+				rasterReplayStats.beginFrame();
+			}
+			rasterizer.beginFrame();
+			recorder.replay(rasterizer);
+			rasterizer.endFrame();
+			if (measured) {
+				rasterReplayStats.endFrame();
+			}
+		}
+
+		// Written after the frame's timings, so the image files don't count towards them
+		if (!outputPattern.empty() && frame >= warmup) {
+			SoftwareRasterizer::formatFramePath(outputPattern, frame - warmup, outputPath);
+			if (!rasterizer.writeImage(outputPath)) {
+				cerr << "could not write " << outputPath << endl;
+				return 1;
+			}
+		}
+	}
+
+	if (record) {
+		cout << "recorded:      " << recorder.getCommands().size() << " commands, " << recorder.getPrimitiveCount()
+			<< " primitives, " << recorder.getVertexCount() << " vertices per frame\n"
+			<< "-- recording the scene and stepping the carts\n";
+	}
+	stats.print(cout, cartCount, "carts");
+	if (record) {
+		cout << "-- replay into null\n";
+		nullReplayStats.print(cout, cartCount, "carts");
+		cout << "-- replay into raster\n";
+		rasterReplayStats.print(cout, cartCount, "carts");
+	}
+	return 0;
+}
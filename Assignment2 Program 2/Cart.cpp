@@ -2,14 +2,16 @@
 #define _USE_MATH_DEFINES
 
 #include "Cart.h"
-#include "glPlatform.h"
+#include "UnitCircle.h"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 // Constructor implementation
 Cart::Cart(float posX, float posY, float orientation, float scale)
-    : positionX_(posX), positionY_(posY), orientation_(orientation), scale_(scale),
-    wheelRotationAngle_(0.0f), movingLeft_(false) {
+    : ComplexGraphicObject2D(), scale_(scale), wheelRotationAngle_(0.0f), movingLeft_(false) {
+    GraphicObject2D::setPosition(posX, posY);
+    GraphicObject2D::setOrientation(orientation);
     cartWidth_ = 3.0f * scale;
     cartHeight_ = 1.5f * scale;
     wheelRadius_ = 0.5f * scale;  // Initialize the wheel radius
@@ -34,65 +36,68 @@ void Cart::rotateWheels(float tangentialSpeed) {
 }
 
 
-// Modified draw method to handle different appearances when moving left or right
-void Cart::draw() const {
-    glPushMatrix();  // Save the current transformation matrix
+// The box is symmetric so it stays valid when the cart is turned around to move left
+BoundingBox2D Cart::getLocalBounds() const {
+    float halfWidth = std::max(cartWidth_ / 2 + 0.5f, cartWidth_ / 3 + wheelRadius_);
+    float halfHeight = cartHeight_ / 2 + wheelRadius_;
+    return { -halfWidth, -halfHeight, halfWidth, halfHeight };
+}
 
-    // Translate to the cart's current position using the updated positionX_ and positionY_
-    glTranslatef(positionX_, positionY_, 0.0f);
+// Modified draw method to handle different appearances when moving left or right
+void Cart::draw(RenderContext& context) const {
+    context.pushMatrix();  // Save the current transformation matrix
 
-    // Apply rotation based on the cart's orientation
-    glRotatef(orientation_, 0.0f, 0.0f, 1.0f);  // Rotate around the z-axis
+    // Translate to the cart's position and rotate by its orientation using the cached matrix
+    context.multMatrix(getTransform());
 
     // If the cart is moving to the left, rotate it 180 degrees to face the other direction
     if (movingLeft_) {
-        glRotatef(180.0f, 0.0f, 0.0f, 1.0f);  // Rotate the cart 180 degrees on the z-axis
+        context.rotate(180.0f);  // Rotate the cart 180 degrees on the z-axis
     }
 
     // Draw the cart body (a simple rectangle)
-    glColor3f(0.5f, 0.5f, 0.5f);  // Gray color for the cart body
-    glBegin(GL_QUADS);
-    glVertex2f(-cartWidth_ / 2, -cartHeight_ / 2);
-    glVertex2f(cartWidth_ / 2, -cartHeight_ / 2);
-    glVertex2f(cartWidth_ / 2, cartHeight_ / 2);
-    glVertex2f(-cartWidth_ / 2, cartHeight_ / 2);
-    glEnd();
+    context.setColor(0.5f, 0.5f, 0.5f);  // Gray color for the cart body
+    context.begin(PrimitiveType::QUADS);
+    context.vertex(-cartWidth_ / 2, -cartHeight_ / 2);
+    context.vertex(cartWidth_ / 2, -cartHeight_ / 2);
+    context.vertex(cartWidth_ / 2, cartHeight_ / 2);
+    context.vertex(-cartWidth_ / 2, cartHeight_ / 2);
+    context.end();
 
     float triangleOffset = (movingLeft_) ? -cartWidth_ / 2 : cartWidth_ / 2;
-    glBegin(GL_TRIANGLES);
-    glVertex2f(triangleOffset, cartHeight_ / 2);
-    glVertex2f(triangleOffset + 0.5f * (movingLeft_ ? -1 : 1), 0.0f);
-    glVertex2f(triangleOffset, -cartHeight_ / 2);
-    glEnd();
+    context.begin(PrimitiveType::TRIANGLES);
+    context.vertex(triangleOffset, cartHeight_ / 2);
+    context.vertex(triangleOffset + 0.5f * (movingLeft_ ? -1 : 1), 0.0f);
+    context.vertex(triangleOffset, -cartHeight_ / 2);
+    context.end();
 
     // Draw the wheels with spokes
+    const std::vector<UnitCirclePoint>& rim = UnitCircle::get(12);
     for (int i = -1; i <= 1; i += 2) {  // Two wheels, one at each end
-        glPushMatrix();
-        glTranslatef(i * (cartWidth_ / 3), -cartHeight_ / 2, 0.0f);  // Move to the wheel position
-        glRotatef(wheelRotationAngle_, 0.0f, 0.0f, 1.0f);  // Rotate the wheel according to its angle
-
-        // Draw the wheel as a circle
-        glColor3f(1.0f, 1.0f, 1.0f);  // White color for the wheel
-        glBegin(GL_LINE_LOOP);
-        for (int angle = 0; angle < 360; angle += 30) {
-            float rad = angle * static_cast<float>(M_PI) / 180.0f;
-            glVertex2f(wheelRadius_ * cos(rad), wheelRadius_ * sin(rad));
+        context.pushMatrix();
+        context.translate(i * (cartWidth_ / 3), -cartHeight_ / 2);  // Move to the wheel position
+        context.rotate(wheelRotationAngle_);  // Rotate the wheel according to its angle
+
+        // Draw the wheel as a circle (one point every 30 degrees)
+        context.setColor(1.0f, 1.0f, 1.0f);  // White color for the wheel
+        context.begin(PrimitiveType::LINE_LOOP);
+        for (const UnitCirclePoint& p : rim) {
+            context.vertex(wheelRadius_ * p.x, wheelRadius_ * p.y);
         }
-        glEnd();
-
-        // Draw the spokes for the wheel
-        glBegin(GL_LINES);
-        for (int angle = 0; angle < 360; angle += 90) {
-            float rad = angle * static_cast<float>(M_PI) / 180.0f;
-            glVertex2f(0, 0);
-            glVertex2f(wheelRadius_ * cos(rad), wheelRadius_ * sin(rad));
+        context.end();
+
+        // Draw the spokes for the wheel, every third rim point is a multiple of 90 degrees
+        context.begin(PrimitiveType::LINES);
+        for (size_t k = 0; k < rim.size(); k += 3) {
+            context.vertex(0, 0);
+            context.vertex(wheelRadius_ * rim[k].x, wheelRadius_ * rim[k].y);
         }
-        glEnd();
+        context.end();
 
-        glPopMatrix();  // Restore the transformation matrix for each wheel
+        context.popMatrix();  // Restore the transformation matrix for each wheel
     }
 
-    glPopMatrix();  // Restore the original transformation matrix
+    context.popMatrix();  // Restore the original transformation matrix
 }
 
 float Cart::getWheelRadius() const {
@@ -101,23 +106,22 @@ float Cart::getWheelRadius() const {
 
 // Getter for positionX
 float Cart::getPositionX() const {
-    return positionX_;
+    return GraphicObject2D::getPositionX();
 }
 
 // Getter for positionY
 float Cart::getPositionY() const {
-    return positionY_;
+    return GraphicObject2D::getPositionY();
 }
 
 // Setter for position
 void Cart::setPosition(float x, float y) {
-    positionX_ = x;
-    positionY_ = y;
+    GraphicObject2D::setPosition(x, y);
 }
 
 // Setter for orientation
 void Cart::setOrientation(float angle) {
-    orientation_ = angle;
+    GraphicObject2D::setOrientation(angle);
 }
 
 // Setter for direction
@@ -127,5 +131,5 @@ void Cart::setDirection(bool isMovingLeft) {
 
 // Getter for orientation (if needed)
 float Cart::getOrientation() const {
-    return orientation_;
+    return GraphicObject2D::getOrientation();
 }
@@ -15,27 +15,12 @@
  */
 class Cart : public ComplexGraphicObject2D {
 private:
-    /**
-     * @var positionX_
-     * @brief X-coordinate of the cart's position.
-     */
-    float positionX_;
-
-    /**
-     * @var positionY_
-     * @brief Y-coordinate of the cart's position.
-     */
-    float positionY_;
-
-    /**
-     * @var orientation_
-     * @brief Orientation angle of the cart.
-     */
-    float orientation_;
-
     /**
      * @var scale_
-     * @brief Scale factor of the cart.
+     * @brief Scale factor the cart's dimensions were built with.
+     *
+     * The size is baked into cartWidth_, cartHeight_ and wheelRadius_, so the GraphicObject2D
+     * scale stays at 1 and the position and orientation live in GraphicObject2D.
      */
     float scale_;
 
@@ -130,12 +115,42 @@ public:
      */
     float getWheelRadius() const;
 
+    /**
+     * @brief Gets the size factor the cart was created with.
+     *
+     * @return The cart's scale.
+     */
+    float getCartScale() const { return scale_; }
+
+    /**
+     * @brief Gets the rotation of the wheels.
+     *
+     * @return The wheel angle in degrees, between 0 and 360.
+     */
+    float getWheelRotation() const { return wheelRotationAngle_; }
+
+    /**
+     * @brief Sets the rotation of the wheels, as when restoring a saved cart.
+     *
+     * @param angle The wheel angle in degrees.
+     */
+    void setWheelRotation(float angle) { wheelRotationAngle_ = angle; }
+
     /**
      * @brief Draws the cart and its components on the screen.
      *
      * Overrides the draw method from ComplexGraphicObject2D to render the cart.
+     *
+     * @param context The render context to draw into.
+     */
+    void draw(RenderContext& context) const override;
+
+    /**
+     * @brief Gets a box enclosing the body, nose and wheels, whichever way the cart faces.
+     *
+     * @return The cart's local bounds.
      */
-    void draw() const override;
+    BoundingBox2D getLocalBounds() const override;
 
     /**
      * @brief Rotates the wheels of the cart based on the given speed.
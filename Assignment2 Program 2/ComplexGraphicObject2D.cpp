@@ -1,18 +1,100 @@
 #include "ComplexGraphicObject2D.h"
+#include <algorithm>
+#include <cmath>
 
-ComplexGraphicObject2D::ComplexGraphicObject2D() : GraphicObject2D() {
+ComplexGraphicObject2D::ComplexGraphicObject2D(std::pmr::memory_resource* resource)
+    : GraphicObject2D(), parts(resource), localBounds_(BoundingBox2D::empty()), boundsDirty_(false) {
 }
 
 // stores all the specifc graphic objects contained in the complex graphic object
-void ComplexGraphicObject2D::addPart(std::shared_ptr<GraphicObject2D> part) {
-    parts.push_back(part);
+void ComplexGraphicObject2D::addPart(std::shared_ptr<GraphicObject2D> part, bool inheritOrientation) {
+    addPart(part.get(), inheritOrientation);
+    ownedParts.push_back(std::move(part));
 }
 
-void ComplexGraphicObject2D::draw() const {
-    // Iterate through the list of parts and call their draw methods
-    for (const auto& part : parts) {
-        if (part) {
-            part->draw(); // Draw each part relative to this ComplexGraphicObject2D
+void ComplexGraphicObject2D::addPart(GraphicObject2D* part, bool inheritOrientation) {
+    parts.push_back({ part, inheritOrientation, BoundingBox2D::empty() });
+    boundsDirty_ = true;
+}
+
+Affine2D ComplexGraphicObject2D::getPartSpace(size_t index) const {
+    const Part& part = parts[index];
+    if (part.inheritOrientation || !part.object) {
+        return getTransform();
+    }
+
+    // Undo this object's rotation around the part's own position
+    float px = part.object->getPositionX();
+    float py = part.object->getPositionY();
+    return getTransform() * Affine2D::translation(px, py) * Affine2D::rotation(-getOrientation()) *
+        Affine2D::translation(-px, -py);
+}
+
+BoundingBox2D ComplexGraphicObject2D::getLocalBounds() const {
+    updateBounds();
+    return localBounds_;
+}
+
+void ComplexGraphicObject2D::updateBounds() const {
+    if (!boundsDirty_) {
+        return;
+    }
+
+    localBounds_ = BoundingBox2D::empty();
+    for (Part& part : parts) {
+        part.bounds = BoundingBox2D::empty();
+        if (!part.object) {
+            continue;
         }
+        BoundingBox2D box = part.object->getBounds();
+        if (!part.inheritOrientation && !box.isEmpty() && !box.isInfinite()) {
+            // The part is counter-rotated about its position, so use the square around the circle
+            // its box sweeps; that holds whatever this object's orientation is
+            float px = part.object->getPositionX();
+            float py = part.object->getPositionY();
+            float dx = std::max(std::abs(box.minX - px), std::abs(box.maxX - px));
+            float dy = std::max(std::abs(box.minY - py), std::abs(box.maxY - py));
+            float radius = std::sqrt(dx * dx + dy * dy);
+            box = { px - radius, py - radius, px + radius, py + radius };
+        }
+        part.bounds = box;
+        localBounds_.merge(box);
     }
+    boundsDirty_ = false;
+}
+
+void ComplexGraphicObject2D::draw(RenderContext& context) const {
+    // Parts are positioned relative to this object, so apply its transformation first
+    context.pushMatrix();
+    context.multMatrix(getTransform());
+    float pixelsPerUnit = context.getPixelsPerUnit();
+    context.setPixelsPerUnit(pixelsPerUnit * getScale());
+    BoundingBox2D viewBounds = context.getViewBounds();
+    context.setViewBounds(viewBounds.transformed(getTransform().inverse()));
+    updateBounds();
+
+    // Iterate through the part table and call the parts' draw methods
+    for (const Part& part : parts) {
+        if (!part.object || !context.isVisible(part.bounds)) {
+            continue;
+        }
+        if (part.inheritOrientation) {
+            part.object->draw(context); // Draw each part relative to this ComplexGraphicObject2D
+        }
+        else {
+            // Counter-rotate around the part's position so it keeps its own orientation on screen
+            float px = part.object->getPositionX();
+            float py = part.object->getPositionY();
+            context.pushMatrix();
+            context.translate(px, py);
+            context.rotate(-getOrientation());
+            context.translate(-px, -py);
+            part.object->draw(context);
+            context.popMatrix();
+        }
+    }
+
+    context.setViewBounds(viewBounds);
+    context.setPixelsPerUnit(pixelsPerUnit);
+    context.popMatrix();
 }
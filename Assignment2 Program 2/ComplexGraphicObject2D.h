@@ -4,6 +4,7 @@
 #include "GraphicObject2D.h"
 #include <vector>
 #include <memory>
+#include <memory_resource>
 
 /**
  * @class ComplexGraphicObject2D
@@ -13,7 +14,8 @@
  * multiple other GraphicObject2D objects. The parts can be added and rendered as a unified object.
  * The draw function is overridden to draw all the parts of the complex object.
  *
- * @note Parts are stored as shared pointers, allowing for flexible memory management.
+ * @note Parts are either shared pointers the object keeps alive or non-owning pointers to objects
+ *       that outlive it (such as objects created in a scene arena).
  *
  * @author Harrison Grenier
  */
@@ -23,8 +25,11 @@ public:
      * @brief Constructs an empty ComplexGraphicObject2D.
      *
      * Initializes the object with no parts. Parts can be added using the addPart method.
+     *
+     * @param resource Memory the part table is allocated from, e.g. SceneArena::getResource()
+     *        so the table sits next to the object. Defaults to the heap.
      */
-    ComplexGraphicObject2D();
+    explicit ComplexGraphicObject2D(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /**
      * @brief Destructor for ComplexGraphicObject2D.
@@ -39,25 +44,136 @@ public:
      * The part must be a shared pointer to a GraphicObject2D. This allows for composition of multiple graphic objects.
      *
      * @param part A shared pointer to the part (a GraphicObject2D) to add to this complex object.
+     * @param inheritOrientation If false, the part keeps its own orientation on screen while the
+     *        object rotates (it still follows the object's position and scale).
+     */
+    void addPart(std::shared_ptr<GraphicObject2D> part, bool inheritOrientation = true);
+
+    /**
+     * @brief Adds a part the object doesn't own.
+     *
+     * Used for parts created in a SceneArena, which must outlive this object.
+     *
+     * @param part The part to add.
+     * @param inheritOrientation If false, the part keeps its own orientation on screen while the
+     *        object rotates (it still follows the object's position and scale).
+     */
+    void addPart(GraphicObject2D* part, bool inheritOrientation = true);
+
+    /**
+     * @brief Reserves room for parts so adding them doesn't reallocate the part table.
+     *
+     * @param count Total number of parts the object will hold.
+     */
+    void reserveParts(size_t count) { parts.reserve(count); }
+
+    /**
+     * @brief Gets the number of parts that make up the complex graphic object.
+     *
+     * @return The part count.
+     */
+    size_t getPartCount() const { return parts.size(); }
+
+    /**
+     * @brief Gets one of the parts that make up the complex graphic object.
+     *
+     * @param index Index of the part, in drawing order.
+     * @return The part.
+     */
+    GraphicObject2D* getPart(size_t index) const { return parts[index].object; }
+
+    /**
+     * @brief Tells whether a part rotates along with this object.
+     *
+     * @param index Index of the part, as for getPart().
+     * @return False if the part keeps its own orientation on screen.
+     */
+    bool getPartInheritsOrientation(size_t index) const { return parts[index].inheritOrientation; }
+
+    /**
+     * @brief Gets the transformation from a part's parent space to this object's parent space.
+     *
+     * Part positions, orientations and scales are relative to this object, so this is the
+     * object's own transformation, plus a counter-rotation for parts that don't inherit orientation.
+     *
+     * @param index Index of the part, as for getPart().
+     * @return The matrix to apply before the part's own transformation.
      */
-    void addPart(std::shared_ptr<GraphicObject2D> part);
+    Affine2D getPartSpace(size_t index) const;
+
+    /**
+     * @brief Gets the merged bounds of all parts, in this object's model space.
+     *
+     * Parts that don't inherit orientation contribute a box that holds for any orientation of this
+     * object, so rotating the object doesn't invalidate it. The result is cached; call
+     * invalidateBounds() after moving or resizing a part that was already added.
+     *
+     * @return The merged bounds of the parts.
+     */
+    BoundingBox2D getLocalBounds() const override;
+
+    /**
+     * @brief Discards the cached bounds so they are rebuilt from the parts on next use.
+     */
+    void invalidateBounds() { boundsDirty_ = true; }
 
     /**
      * @brief Draws the complex graphic object.
      *
      * This method overrides the draw function from GraphicObject2D to render all the parts that
      * compose this complex object.
+     *
+     * The object's own position, orientation and scale are applied first, so parts are laid out
+     * relative to the object and moving, rotating or scaling it is a single state change.
+     *
+     * Parts whose bounds fall outside the context's view bounds are skipped.
+     *
+     * @param context The render context to draw into.
      */
-    void draw() const override;
+    void draw(RenderContext& context) const override;
 
 private:
+    /**
+     * @brief Rebuilds the part bounds and localBounds_ if they are out of date.
+     */
+    void updateBounds() const;
+
+    /**
+     * @struct Part
+     * @brief One entry of the part table, with everything draw() needs kept together.
+     */
+    struct Part {
+        GraphicObject2D* object;  /**< The part itself */
+        bool inheritOrientation;  /**< Whether the part rotates along with this object */
+        BoundingBox2D bounds;     /**< The part's bounds in this object's model space */
+    };
+
     /**
      * @var parts
-     * @brief List of parts that make up the complex graphic object.
+     * @brief The parts that make up the complex graphic object, in drawing order.
      *
-     * Each part is a shared pointer to a GraphicObject2D. These parts are drawn together as a single object.
+     * The parts are drawn together to form the complete complex object. Bounds are updated lazily,
+     * hence mutable.
+     */
+    mutable std::pmr::vector<Part> parts;
+
+    /**
+     * @var ownedParts
+     * @brief Keeps alive the parts that were added as shared pointers.
+     */
+    std::vector<std::shared_ptr<GraphicObject2D>> ownedParts;
+
+    /**
+     * @var localBounds_
+     * @brief Cached union of the part bounds.
+     */
+    mutable BoundingBox2D localBounds_;
+
+    /**
+     * @var boundsDirty_
+     * @brief True when a part was added since the bounds were last built.
      */
-    std::vector<std::shared_ptr<GraphicObject2D>> parts;
+    mutable bool boundsDirty_;
 };
 
 #endif // COMPLEXGRAPHICOBJECT2D_H
@@ -0,0 +1,79 @@
+#ifndef DUAL_H
+#define DUAL_H
+
+#include <cmath>
+
+/**
+ * @struct Dual
+ * @brief Dual number a + b·ε (with ε² = 0) for forward-mode automatic differentiation.
+ *
+ * Evaluating a function written for a generic number type with Dual{x, 1} gives f(x) in value and
+ * f'(x) in derivative, exactly and in the same pass, so a curve's slope never has to be derived by
+ * hand. Every operation is inline, so the compiler reduces the evaluation to plain arithmetic.
+ *
+ * @tparam T Underlying scalar type.
+ *
+ * @author Harrison Grenier
+ */
+template <class T>
+struct Dual {
+    T value;      /**< Value of the function */
+    T derivative; /**< Derivative of the function with respect to its input */
+
+    /**
+     * @brief Constructs a constant, whose derivative is 0.
+     *
+     * @param constant The value.
+     */
+    constexpr Dual(T constant = T()) : value(constant), derivative(T()) {}
+
+    /**
+     * @brief Constructs a dual number from its parts.
+     *
+     * @param value The value.
+     * @param derivative The derivative.
+     */
+    constexpr Dual(T value, T derivative) : value(value), derivative(derivative) {}
+
+    /**
+     * @brief Constructs the input variable of a function, whose derivative with respect to itself is 1.
+     *
+     * @param x Point the function is evaluated at.
+     * @return x + ε.
+     */
+    static constexpr Dual variable(T x) { return Dual(x, T(1)); }
+};
+
+/** @brief Sum rule. */
+template <class T>
+constexpr Dual<T> operator+(const Dual<T>& a, const Dual<T>& b) { return { a.value + b.value, a.derivative + b.derivative }; }
+
+/** @brief Difference rule. */
+template <class T>
+constexpr Dual<T> operator-(const Dual<T>& a, const Dual<T>& b) { return { a.value - b.value, a.derivative - b.derivative }; }
+
+/** @brief Negation. */
+template <class T>
+constexpr Dual<T> operator-(const Dual<T>& a) { return { -a.value, -a.derivative }; }
+
+/** @brief Product rule. */
+template <class T>
+constexpr Dual<T> operator*(const Dual<T>& a, const Dual<T>& b) {
+    return { a.value * b.value, a.derivative * b.value + a.value * b.derivative };
+}
+
+/** @brief Quotient rule. */
+template <class T>
+constexpr Dual<T> operator/(const Dual<T>& a, const Dual<T>& b) {
+    return { a.value / b.value, (a.derivative * b.value - a.value * b.derivative) / (b.value * b.value) };
+}
+
+/** @brief Sine, with derivative cos. */
+template <class T>
+Dual<T> sin(const Dual<T>& a) { return { std::sin(a.value), std::cos(a.value) * a.derivative }; }
+
+/** @brief Cosine, with derivative -sin. */
+template <class T>
+Dual<T> cos(const Dual<T>& a) { return { std::cos(a.value), -std::sin(a.value) * a.derivative }; }
+
+#endif // DUAL_H
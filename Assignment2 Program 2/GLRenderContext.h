@@ -0,0 +1,45 @@
+#ifndef GLRENDERCONTEXT_H
+#define GLRENDERCONTEXT_H
+
+#include "RenderContext.h"
+
+/**
+ * @class GLRenderContext
+ * @brief RenderContext backend that forwards every call to immediate-mode OpenGL.
+ *
+ * This is the backend the interactive program draws with; each call maps one-to-one onto the
+ * glColor3f / glBegin / glVertex2f / glEnd and matrix stack calls the scene used to make itself.
+ *
+ * @note A GL context must be current (i.e. the GLUT window must exist) when drawing.
+ *
+ * @see RenderContext
+ *
+ * @author Harrison Grenier
+ */
+class GLRenderContext : public RenderContext {
+public:
+    /** @brief Forwards to glColor3f. */
+    void setColor(float r, float g, float b) override;
+    /** @brief Forwards to glBegin with the matching GL mode. */
+    void begin(PrimitiveType type) override;
+    /** @brief Forwards to glVertex2f. */
+    void vertex(float x, float y) override;
+    /** @brief Forwards to glEnd. */
+    void end() override;
+    /** @brief Draws the array with glDrawArrays. */
+    void drawVertices(PrimitiveType type, const float* xy, size_t count) override;
+    /** @brief Forwards to glPushMatrix. */
+    void pushMatrix() override;
+    /** @brief Forwards to glPopMatrix. */
+    void popMatrix() override;
+    /** @brief Forwards to glTranslatef. */
+    void translate(float x, float y) override;
+    /** @brief Forwards to glRotatef about the Z axis. */
+    void rotate(float angle) override;
+    /** @brief Forwards to glScalef. */
+    void scale(float sx, float sy) override;
+    /** @brief Forwards to glMultMatrixf. */
+    void multMatrix(const Affine2D& m) override;
+};
+
+#endif // GLRENDERCONTEXT_H
@@ -1,6 +1,10 @@
 #ifndef GRAPHICOBJECT2D_H
 #define GRAPHICOBJECT2D_H
 
+#include "RenderContext.h"
+#include "Affine2D.h"
+#include "BoundingBox2D.h"
+
 /**
  * @class GraphicObject2D
  * @brief Base class for 2D graphic objects with position, orientation, and scale properties.
@@ -39,6 +43,18 @@ private:
      */
     float scale_;
 
+    /**
+     * @var transform_
+     * @brief Cached transformation built from position, orientation and scale.
+     */
+    mutable Affine2D transform_;
+
+    /**
+     * @var transformDirty_
+     * @brief True when a setter has changed the object since transform_ was last built.
+     */
+    mutable bool transformDirty_;
+
 public:
     /**
      * @brief Constructs a 2D graphic object with specified position, orientation, and scale.
@@ -49,7 +65,8 @@ public:
      * @param scale Initial scale factor. Default is 1.0.
      */
     GraphicObject2D(float posX = 0, float posY = 0, float orientation = 0, float scale = 1.0f)
-        : positionX_(posX), positionY_(posY), orientation_(orientation), scale_(scale) {}
+        : positionX_(posX), positionY_(posY), orientation_(orientation), scale_(scale),
+        transform_(Affine2D::identity()), transformDirty_(true) {}
 
     /**
      * @brief Sets the position of the object.
@@ -57,7 +74,7 @@ public:
      * @param x New X-coordinate position.
      * @param y New Y-coordinate position.
      */
-    void setPosition(float x, float y) { positionX_ = x; positionY_ = y; }
+    void setPosition(float x, float y) { positionX_ = x; positionY_ = y; transformDirty_ = true; }
 
     /**
      * @brief Gets the X-coordinate of the object's position.
@@ -78,7 +95,7 @@ public:
      *
      * @param angle New orientation angle in degrees.
      */
-    void setOrientation(float angle) { orientation_ = angle; }
+    void setOrientation(float angle) { orientation_ = angle; transformDirty_ = true; }
 
     /**
      * @brief Gets the orientation (rotation) of the object.
@@ -92,7 +109,7 @@ public:
      *
      * @param scale New scale factor.
      */
-    void setScale(float scale) { scale_ = scale; }
+    void setScale(float scale) { scale_ = scale; transformDirty_ = true; }
 
     /**
      * @brief Gets the scale factor of the object.
@@ -101,12 +118,47 @@ public:
      */
     float getScale() const { return scale_; }
 
+    /**
+     * @brief Gets the object's transformation: translate by position, rotate by orientation, then scale.
+     *
+     * The matrix is cached and only rebuilt (with one sin/cos evaluation) after setPosition,
+     * setOrientation or setScale has changed the object, so objects that don't move cost nothing.
+     *
+     * @return The cached transformation.
+     */
+    const Affine2D& getTransform() const {
+        if (transformDirty_) {
+            transform_ = Affine2D::fromTransform(positionX_, positionY_, orientation_, scale_);
+            transformDirty_ = false;
+        }
+        return transform_;
+    }
+
+    /**
+     * @brief Gets a box enclosing everything the object draws, in its own model space.
+     *
+     * The box is taken before the object's position, orientation and scale are applied. Objects
+     * that don't override this return an infinite box and are never culled.
+     *
+     * @return The object's local bounds.
+     */
+    virtual BoundingBox2D getLocalBounds() const { return BoundingBox2D::infinite(); }
+
+    /**
+     * @brief Gets a box enclosing everything the object draws, in its parent's space.
+     *
+     * @return The local bounds transformed by getTransform().
+     */
+    BoundingBox2D getBounds() const { return getLocalBounds().transformed(getTransform()); }
+
     /**
      * @brief Pure virtual function to draw the object.
      *
      * This method must be overridden by derived classes to implement object-specific drawing functionality.
+     *
+     * @param context The render context to draw into.
      */
-    virtual void draw() const = 0;
+    virtual void draw(RenderContext& context) const = 0;
 };
 
 #endif // GRAPHICOBJECT2D_H
@@ -0,0 +1,262 @@
+#ifndef INPUTRECORDER_H
+#define INPUTRECORDER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * @enum InputEventType
+ * @brief Kinds of event an input log holds.
+ */
+enum class InputEventType : uint8_t {
+    KEYBOARD = 1, /**< Key press: key, pointer x and y */
+    MOUSE = 2,    /**< Mouse button change: button, state, pointer x and y */
+    MOTION = 3,   /**< Pointer moved with a button held: x and y */
+    RESIZE = 4,   /**< Window resized: width in x, height in y */
+    TICKS = 5     /**< Simulation ticks run by one idle call: count in x */
+};
+
+/**
+ * @struct InputEvent
+ * @brief One recorded event, stored as is in the log file.
+ */
+struct InputEvent {
+    uint64_t time;       /**< Microseconds since recording started */
+    InputEventType type; /**< Kind of the event */
+    uint8_t key;         /**< Key pressed, for KEYBOARD */
+    uint8_t button;      /**< GLUT mouse button, for MOUSE */
+    uint8_t state;       /**< GLUT button state, for MOUSE */
+    int32_t x;           /**< Pointer x, window width or tick count, depending on the type */
+    int32_t y;           /**< Pointer y or window height, depending on the type */
+};
+
+static_assert(sizeof(InputEvent) == 24, "InputEvent is part of the file format");
+
+/**
+ * @struct InputHandlers
+ * @brief Functions replayed events are passed to, in the form of the GLUT callbacks; any can be null.
+ */
+struct InputHandlers {
+    void (*keyboard)(unsigned char key, int x, int y); /**< Receives KEYBOARD events */
+    void (*mouse)(int button, int state, int x, int y); /**< Receives MOUSE events */
+    void (*motion)(int x, int y);                       /**< Receives MOTION events */
+    void (*resize)(int width, int height);              /**< Receives RESIZE events */
+    void (*ticks)(int count);                           /**< Receives TICKS events */
+};
+
+/**
+ * @class InputRecorder
+ * @brief Records the input of a session into a compact log and feeds it back later.
+ *
+ * Besides keyboard, mouse and resize events, the log holds the number of simulation ticks each idle
+ * call ran. A replay runs exactly those ticks between exactly those events, regardless of how fast
+ * the machine is, so the same scene and workload are reproduced bit for bit on every build. Events
+ * are replayed either at the pace they were recorded or as fast as possible, one tick batch per
+ * call, which makes the replay a repeatable benchmark.
+ *
+ * A log is a header (magic "A2INPUT", version) followed by InputEvent records in the machine's own
+ * (little-endian) layout.
+ *
+ * @author Harrison Grenier
+ */
+class InputRecorder {
+public:
+    /**
+     * @brief Version written into new logs; newer logs are rejected.
+     */
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Constructs a recorder that neither records nor replays.
+     */
+    InputRecorder();
+
+    /**
+     * @brief Writes out any events still buffered and closes the log.
+     */
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    /**
+     * @brief Creates a log and starts recording into it, with time counted from now.
+     *
+     * @param path File to write.
+     * @return True if the file could be created.
+     */
+    bool startRecording(const std::string& path);
+
+    /**
+     * @brief Writes out any events still buffered and closes the log.
+     *
+     * @return True if every event was written.
+     */
+    bool stopRecording();
+
+    /**
+     * @brief Checks whether events are being recorded.
+     *
+     * @return True between startRecording() and stopRecording().
+     */
+    bool isRecording() const { return file_ != nullptr; }
+
+    /**
+     * @brief Records a key press; ignored unless recording.
+     *
+     * @param key The key pressed.
+     * @param x Pointer x in window pixels.
+     * @param y Pointer y in window pixels.
+     */
+    void recordKeyboard(unsigned char key, int x, int y);
+
+    /**
+     * @brief Records a mouse button change; ignored unless recording.
+     *
+     * @param button GLUT mouse button.
+     * @param state GLUT button state.
+     * @param x Pointer x in window pixels.
+     * @param y Pointer y in window pixels.
+     */
+    void recordMouse(int button, int state, int x, int y);
+
+    /**
+     * @brief Records a pointer move with a button held; ignored unless recording.
+     *
+     * @param x Pointer x in window pixels.
+     * @param y Pointer y in window pixels.
+     */
+    void recordMotion(int x, int y);
+
+    /**
+     * @brief Records a window resize; ignored unless recording.
+     *
+     * @param width New width in pixels.
+     * @param height New height in pixels.
+     */
+    void recordResize(int width, int height);
+
+    /**
+     * @brief Records the simulation ticks run by one idle call; ignored unless recording or if count is 0.
+     *
+     * @param count Number of ticks run.
+     */
+    void recordTicks(int count);
+
+    /**
+     * @brief Reads a log and prepares to replay it from the start.
+     *
+     * @param path File to read.
+     * @param maxSpeed True to replay as fast as possible, false to keep the recorded pace.
+     * @return True if the file is a valid log; on failure getError() tells why.
+     */
+    bool loadReplay(const std::string& path, bool maxSpeed);
+
+    /**
+     * @brief Checks whether a loaded log still has events to replay.
+     *
+     * @return True until every event has been passed on.
+     */
+    bool isReplaying() const { return next_ < events_.size(); }
+
+    /**
+     * @brief Passes the events that are due to the handlers.
+     *
+     * At the recorded pace, that is every event recorded no later after the start than the replay
+     * has been running (the clock starts at the first call). At maximum speed, it is every event up
+     * to and including the next tick batch, so each call advances the simulation once.
+     *
+     * @param handlers Functions to pass the events to.
+     * @return Number of events passed on.
+     */
+    size_t replay(const InputHandlers& handlers);
+
+    /**
+     * @brief Gets the number of events in the loaded log.
+     *
+     * @return The event count.
+     */
+    size_t getEventCount() const { return events_.size(); }
+
+    /**
+     * @brief Gets the reason the last loadReplay() failed.
+     *
+     * @return A description of the error, or an empty string.
+     */
+    const std::string& getError() const { return error_; }
+
+private:
+    /**
+     * @brief Stamps an event with the current time and buffers it.
+     *
+     * @param event The event, with its time left to be set.
+     */
+    void append(InputEvent event);
+
+    /**
+     * @brief Writes the buffered events to the log.
+     *
+     * @return True if all of them were written.
+     */
+    bool flush();
+
+    /**
+     * @var file_
+     * @brief Log being recorded, or null.
+     */
+    std::FILE* file_;
+
+    /**
+     * @var writeOk_
+     * @brief False once a write to the log has failed.
+     */
+    bool writeOk_;
+
+    /**
+     * @var start_
+     * @brief When recording or replaying started.
+     */
+    std::chrono::steady_clock::time_point start_;
+
+    /**
+     * @var pending_
+     * @brief Events recorded but not yet written.
+     */
+    std::vector<InputEvent> pending_;
+
+    /**
+     * @var events_
+     * @brief Events of the log being replayed.
+     */
+    std::vector<InputEvent> events_;
+
+    /**
+     * @var next_
+     * @brief Index of the next event to replay.
+     */
+    size_t next_;
+
+    /**
+     * @var maxSpeed_
+     * @brief True to replay as fast as possible.
+     */
+    bool maxSpeed_;
+
+    /**
+     * @var started_
+     * @brief True once the replay clock has been started.
+     */
+    bool started_;
+
+    /**
+     * @var error_
+     * @brief Reason the last loadReplay() failed.
+     */
+    std::string error_;
+};
+
+#endif // INPUTRECORDER_H
@@ -0,0 +1,67 @@
+#include "RecordingRenderContext.h"
+
+void RecordingRenderContext::setColor(float r, float g, float b) {
+    record(RenderOp::SET_COLOR, r, g, b);
+}
+
+void RecordingRenderContext::begin(PrimitiveType type) {
+    record(RenderOp::BEGIN, static_cast<float>(type));
+    primitiveCount_++;
+}
+
+void RecordingRenderContext::vertex(float x, float y) {
+    record(RenderOp::VERTEX, x, y);
+    vertexCount_++;
+}
+
+void RecordingRenderContext::end() {
+    record(RenderOp::END);
+}
+
+void RecordingRenderContext::pushMatrix() {
+    record(RenderOp::PUSH_MATRIX);
+}
+
+void RecordingRenderContext::popMatrix() {
+    record(RenderOp::POP_MATRIX);
+}
+
+void RecordingRenderContext::translate(float x, float y) {
+    record(RenderOp::TRANSLATE, x, y);
+}
+
+void RecordingRenderContext::rotate(float angle) {
+    record(RenderOp::ROTATE, angle);
+}
+
+void RecordingRenderContext::scale(float sx, float sy) {
+    record(RenderOp::SCALE, sx, sy);
+}
+
+void RecordingRenderContext::multMatrix(const Affine2D& m) {
+    commands_.push_back({ RenderOp::MULT_MATRIX, { m.a, m.b, m.c, m.d, m.tx, m.ty } });
+}
+
+void RecordingRenderContext::clear() {
+    commands_.clear();
+    vertexCount_ = 0;
+    primitiveCount_ = 0;
+}
+
+void RecordingRenderContext::replay(RenderContext& target) const {
+    for (const RenderCommand& cmd : commands_) {
+        const float* a = cmd.args;
+        switch (cmd.op) {
+        case RenderOp::SET_COLOR: target.setColor(a[0], a[1], a[2]); break;
+        case RenderOp::BEGIN: target.begin(static_cast<PrimitiveType>(static_cast<int>(a[0]))); break;
+        case RenderOp::VERTEX: target.vertex(a[0], a[1]); break;
+        case RenderOp::END: target.end(); break;
+        case RenderOp::PUSH_MATRIX: target.pushMatrix(); break;
+        case RenderOp::POP_MATRIX: target.popMatrix(); break;
+        case RenderOp::TRANSLATE: target.translate(a[0], a[1]); break;
+        case RenderOp::ROTATE: target.rotate(a[0]); break;
+        case RenderOp::SCALE: target.scale(a[0], a[1]); break;
+        case RenderOp::MULT_MATRIX: target.multMatrix({ a[0], a[1], a[2], a[3], a[4], a[5] }); break;
+        }
+    }
+}
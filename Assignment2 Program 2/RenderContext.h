@@ -0,0 +1,188 @@
+#ifndef RENDERCONTEXT_H
+#define RENDERCONTEXT_H
+
+#include <cstddef>
+#include "Affine2D.h"
+#include "BoundingBox2D.h"
+
+/**
+ * @enum PrimitiveType
+ * @brief The kinds of primitives the drawing code emits between begin() and end().
+ */
+enum class PrimitiveType {
+    POLYGON,    /**< A single filled convex polygon */
+    QUADS,      /**< Independent filled quadrilaterals, four vertices each */
+    TRIANGLES,  /**< Independent filled triangles, three vertices each */
+    LINES,      /**< Independent line segments, two vertices each */
+    LINE_STRIP, /**< A connected open polyline */
+    LINE_LOOP   /**< A connected closed polyline */
+};
+
+/**
+ * @class RenderContext
+ * @brief Abstract target for all scene drawing.
+ *
+ * GraphicObject2D::draw implementations describe their geometry through this interface instead of
+ * calling OpenGL directly. The calls mirror the immediate-mode model the scene was written against
+ * (current color, begin/vertex/end, and a matrix stack), so a backend can forward them to OpenGL,
+ * record them, rasterize them in software, or drop them.
+ *
+ * @see GLRenderContext
+ * @see RecordingRenderContext
+ * @see NullRenderContext
+ *
+ * @author Harrison Grenier
+ */
+class RenderContext {
+public:
+    /**
+     * @brief Default virtual destructor for RenderContext.
+     */
+    virtual ~RenderContext() = default;
+
+    /**
+     * @brief Sets the color used by the following vertices.
+     *
+     * @param r Red color component.
+     * @param g Green color component.
+     * @param b Blue color component.
+     */
+    virtual void setColor(float r, float g, float b) = 0;
+
+    /**
+     * @brief Starts a primitive of the given type.
+     *
+     * @param type The type of primitive the following vertices describe.
+     */
+    virtual void begin(PrimitiveType type) = 0;
+
+    /**
+     * @brief Emits a vertex of the current primitive, in the current model space.
+     *
+     * @param x X-coordinate of the vertex.
+     * @param y Y-coordinate of the vertex.
+     */
+    virtual void vertex(float x, float y) = 0;
+
+    /**
+     * @brief Ends the current primitive.
+     */
+    virtual void end() = 0;
+
+    /**
+     * @brief Draws a whole primitive from an array of vertices, in the current model space.
+     *
+     * Same as begin(type), vertex() for every point and end(). Backends that can take the array as
+     * it is override this, so geometry kept in a buffer is drawn with a single call.
+     *
+     * @param type The type of primitive.
+     * @param xy Interleaved x, y coordinates of the vertices.
+     * @param count Number of vertices.
+     */
+    virtual void drawVertices(PrimitiveType type, const float* xy, size_t count) {
+        begin(type);
+        for (size_t i = 0; i < count; i++) {
+            vertex(xy[2 * i], xy[2 * i + 1]);
+        }
+        end();
+    }
+
+    /**
+     * @brief Saves the current model transformation.
+     */
+    virtual void pushMatrix() = 0;
+
+    /**
+     * @brief Restores the model transformation saved by the matching pushMatrix().
+     */
+    virtual void popMatrix() = 0;
+
+    /**
+     * @brief Appends a translation to the current model transformation.
+     *
+     * @param x Translation along X.
+     * @param y Translation along Y.
+     */
+    virtual void translate(float x, float y) = 0;
+
+    /**
+     * @brief Appends a rotation about the Z axis to the current model transformation.
+     *
+     * @param angle Rotation angle in degrees.
+     */
+    virtual void rotate(float angle) = 0;
+
+    /**
+     * @brief Appends a scale to the current model transformation.
+     *
+     * @param sx Scale factor along X.
+     * @param sy Scale factor along Y.
+     */
+    virtual void scale(float sx, float sy) = 0;
+
+    /**
+     * @brief Appends an arbitrary affine transformation to the current model transformation.
+     *
+     * Objects use this to apply their cached transformation in a single call.
+     *
+     * @param m The transformation to append.
+     */
+    virtual void multMatrix(const Affine2D& m) = 0;
+
+    /**
+     * @brief Sets how many pixels one unit of the current model space covers on screen.
+     *
+     * Drawing code uses this to choose a level of detail. Composite objects multiply it by
+     * their own scale while drawing their parts.
+     *
+     * @param pixelsPerUnit Pixels per model unit, or 0 if unknown (full detail is used).
+     */
+    void setPixelsPerUnit(float pixelsPerUnit) { pixelsPerUnit_ = pixelsPerUnit; }
+
+    /**
+     * @brief Gets how many pixels one unit of the current model space covers on screen.
+     *
+     * @return Pixels per model unit, or 0 if unknown.
+     */
+    float getPixelsPerUnit() const { return pixelsPerUnit_; }
+
+    /**
+     * @brief Sets the visible region, expressed in the current model space.
+     *
+     * Drawing code rejects objects whose bounds fall outside it. Composite objects replace it with
+     * a conservative box in their own space while drawing their parts.
+     *
+     * @param bounds The visible region, or BoundingBox2D::infinite() to disable culling.
+     */
+    void setViewBounds(const BoundingBox2D& bounds) { viewBounds_ = bounds; }
+
+    /**
+     * @brief Gets the visible region, expressed in the current model space.
+     *
+     * @return The visible region (infinite when culling is disabled).
+     */
+    const BoundingBox2D& getViewBounds() const { return viewBounds_; }
+
+    /**
+     * @brief Tells whether a box in the current model space may be visible.
+     *
+     * @param bounds The box to test.
+     * @return False only if the box is certainly outside the visible region.
+     */
+    bool isVisible(const BoundingBox2D& bounds) const { return viewBounds_.intersects(bounds); }
+
+private:
+    /**
+     * @var pixelsPerUnit_
+     * @brief Pixels per model unit, 0 when the viewport is unknown.
+     */
+    float pixelsPerUnit_ = 0.0f;
+
+    /**
+     * @var viewBounds_
+     * @brief Visible region in the current model space, infinite when unknown.
+     */
+    BoundingBox2D viewBounds_ = BoundingBox2D::infinite();
+};
+
+#endif // RENDERCONTEXT_H
@@ -1,92 +1,44 @@
 #define _USE_MATH_DEFINES
 
 #include "Road.h"
-#include "glPlatform.h"  // OpenGL Utility Toolkit for rendering
 #include <cmath>  // For mathematical functions like sin, cos, atan2, etc.
+#include <algorithm>
+#include <vector>
 
 // Constructor to initialize road type
-Road::Road(int roadType) : roadType_(roadType), cart_(nullptr), cartDirection_(1) {}
-
-// Implementation of the hard-coded road equations
-float Road::roadFunc1(float x) const {
-    return 1.0f * std::sin(x) + 2.0f;  // Sine wave road equation
-}
-
-float Road::roadFunc2(float x) const {
-    return -0.05f * (x - 20.0f) * (x - 20.0f) + 20.0f;  // Big hill equation
-}
-
-float Road::roadFunc2Derivative(float x) const {
-    return -0.1f * (x - 20.0f);  // Derivative of the big hill equation
-}
-
-// First derivative of the road equations to get the slope (dy/dx)
-float Road::roadFunc1Derivative(float x) const {
-    return 1.0f * std::cos(x);  // Derivative of the sine wave road
-}
-
-
-// Public method to get the y value for a given x based on road type
-float Road::getY(float x) const {
-    switch (roadType_) {
-    case 1:
-        return roadFunc1(x);
-    case 2:
-        return roadFunc2(x);
-    default:
-        return 0.0f;  // Default flat road if no valid road type is specified
-    }
-}
-
-// Method to calculate the slope using the derivative of the road function
-float Road::getSlope(float x) const {
-    switch (roadType_) {
-    case 1:
-        return roadFunc1Derivative(x);
-    case 2:
-        return roadFunc2Derivative(x);
-    default:
-        return 0.0f;  // Default flat slope if no valid road type is specified
-    }
-}
+Road::Road(int roadType)
+    : roadType_(roadType), cart_(nullptr), cartDirection_(1), shape_(&RoadShape::forType(roadType)), cartDistance_(0.0) {}
 
 // Method to create the cart
 void Road::createCart(float posX, float posY, float orientation, float scale) {
     cart_ = std::make_shared<Cart>(posX, posY, orientation, scale);
     cartDirection_ = 1;  // Set initial direction to right
+    cartDistance_ = shape_->getArcLength().distanceAt(posX);
 }
 
 // Method to move the cart
 void Road::moveCart(float speed) {
     if (cart_) {
-        float currentX = cart_->getPositionX();
-        float slope = getSlope(currentX);  // Get the slope of the road at the current position
-
-        // Calculate the normalized direction vector (tangential to the road)
-        float dx = 1.0f / std::sqrt(1.0f + slope * slope);  // Normalized x-component
-        float dy = slope * dx;  // Normalized y-component
-
-        // Update the position of the cart using the tangential speed
-        float newX = currentX + cartDirection_ * speed * dx;
-        float newY = getY(newX);  // Use the road equation to determine the exact y-position
-
-        // Compute the angle of the cart's orientation based on the slope using atan2
-        float orientationAngle = std::atan2(dy, dx) * (180.0f / static_cast<float>(M_PI));
-        if (cartDirection_ == -1) {  // Moving left
-            orientationAngle += 180.0f;  // Keep the cart upright but facing left
+        // Travel the distance along the road as if it were unfolded at both ends: every length past
+        // an end is driven back the other way, so the position repeats with a period of two lengths
+        const ArcLengthTable& arcLength = shape_->getArcLength();
+        double length = arcLength.getLength();
+        double period = 2.0 * length;
+        double travelled = std::fmod(cartDistance_ + cartDirection_ * speed, period);
+        if (travelled < 0.0) {
+            travelled += period;
         }
+        bool turnedAround = travelled > length;
+        cartDistance_ = turnedAround ? period - travelled : travelled;
 
-        cart_->setPosition(newX, newY);
-        cart_->setOrientation(orientationAngle);
+        // Check if the cart has turned around at the right or left edge of the world
+        if (turnedAround) {
+            flipCartDirection();
+        }
+        placeCart();
 
         float wheelAngularSpeed = speed / cart_->getWheelRadius();  // Convert tangential speed to angular speed
         cart_->rotateWheels(wheelAngularSpeed);
-
-
-        // Check if the cart has reached the right or left edge of the world
-        if (newX >= 40.0f || newX <= 0.0f) {  // Assuming the world range is 0 to 40
-            flipCartDirection();
-        }
     }
 }
 
@@ -100,20 +52,85 @@ void Road::flipCartDirection() {
 }
 
 
-// Method to draw the cart
-void Road::drawCart() const {
+void Road::setCartState(double distance, int direction, float wheelAngle) {
+    if (cart_) {
+        cartDistance_ = distance;
+        if (direction != cartDirection_) {
+            flipCartDirection();
+        }
+        placeCart();
+        cart_->setWheelRotation(wheelAngle);
+    }
+}
+
+// Look up the point at the cart's distance, and face along the road there
+void Road::placeCart() {
+    float newX = static_cast<float>(shape_->getArcLength().xAt(cartDistance_));
+    float newY, slope;
+    shape_->evaluate(newX, newY, slope);  // Height and slope from the road equation, in one call
+    float orientationAngle = std::atan(slope) * (180.0f / static_cast<float>(M_PI));
+    if (cartDirection_ == -1) {  // Moving left
+        orientationAngle += 180.0f;  // Keep the cart upright but facing left
+    }
+
+    cart_->setPosition(newX, newY);
+    cart_->setOrientation(orientationAngle);
+}
+
+RoadRecord Road::toRecord() const {
+    RoadRecord record = { roadType_, cartDirection_, cart_ ? 1u : 0u, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0 };
     if (cart_) {
-        cart_->draw();
+        record.cartX = cart_->getPositionX();
+        record.cartY = cart_->getPositionY();
+        record.cartOrientation = cart_->getOrientation();
+        record.cartScale = cart_->getCartScale();
+        record.cartWheelAngle = cart_->getWheelRotation();
+        record.cartDistance = cartDistance_;
+    }
+    return record;
+}
+
+void Road::restore(const RoadRecord& record) {
+    roadType_ = record.roadType;
+    shape_ = &RoadShape::forType(roadType_);
+    cart_.reset();
+    if (record.hasCart) {
+        createCart(record.cartX, record.cartY, record.cartOrientation, record.cartScale);
+        cart_->setWheelRotation(record.cartWheelAngle);
+
+        // Continue from the stored distance, so the cart moves on exactly as if it had never been saved
+        if (record.cartDistance >= 0.0 && record.cartDistance <= shape_->getArcLength().getLength()) {
+            cartDistance_ = record.cartDistance;
+        }
+    }
+    cartDirection_ = record.cartDirection < 0 ? -1 : 1;
+    if (cart_) {
+        cart_->setDirection(cartDirection_ == -1);
+    }
+}
+
+
+// Method to draw the cart
+void Road::drawCart(RenderContext& context) const {
+    if (cart_ && context.isVisible(cart_->getBounds())) {
+        cart_->draw(context);
     }
 }
 
 // Method to draw the road as a curve using a line strip
-void Road::draw() const {
-    glColor3f(0.0f, 0.0f, 1.0f);  // Set road color to blue
-    glBegin(GL_LINE_STRIP);
-    for (float x = 0.0f; x <= 40.0f; x += 0.1f) {  // Adjust range and step size as needed
-        float y = getY(x);
-        glVertex2f(x, y);
+void Road::draw(RenderContext& context) const {
+    context.setColor(0.0f, 0.0f, 1.0f);  // Set road color to blue
+
+    // The curve is sampled once per road type; submit the part of it that crosses the view
+    // (with a point to spare at both ends) in one call
+    const std::vector<float>& points = shape_->getPolyline();
+    double count = static_cast<double>(points.size() / 2);
+    const BoundingBox2D& view = context.getViewBounds();
+    double from = std::floor((view.minX - RoadShape::START_X) / RoadShape::POLYLINE_STEP) - 1.0;
+    double to = std::ceil((view.maxX - RoadShape::START_X) / RoadShape::POLYLINE_STEP) + 2.0;
+    size_t first = static_cast<size_t>(std::min(std::max(from, 0.0), count));
+    size_t last = static_cast<size_t>(std::min(std::max(to, 0.0), count));
+    if (last > first + 1) {
+        context.drawVertices(PrimitiveType::LINE_STRIP, &points[2 * first], last - first);
     }
-    glEnd();
 }
@@ -3,6 +3,8 @@
 
 #include <memory>
 #include "Cart.h"
+#include "RoadShape.h"
+#include "SceneFile.h"
 
 /**
  * @class Road
@@ -12,6 +14,13 @@
  * and supports rendering the road and cart on the screen. The cart can move left or right, and the slope of
  * the road can be calculated using predefined road functions.
  *
+ * The cart is placed by the distance it has travelled along the road, converted to a position with
+ * an arc-length table of the road, so it drives at exactly its speed on steep and flat sections
+ * alike and with steps of any size.
+ *
+ * The curve itself is a RoadShape, shared by all roads of the same type together with its
+ * arc-length table; the road type is only looked at when the road is created or restored.
+ *
  * @author Harrison Grenier
  */
 class Road {
@@ -35,36 +44,16 @@ private:
     int cartDirection_;
 
     /**
-     * @brief Road equation for the first type of road.
-     *
-     * @param x X-coordinate input for the equation.
-     * @return The corresponding Y-coordinate for the given X, according to road equation 1.
-     */
-    float roadFunc1(float x) const;
-
-    /**
-     * @brief Road equation for the second type of road.
-     *
-     * @param x X-coordinate input for the equation.
-     * @return The corresponding Y-coordinate for the given X, according to road equation 2.
-     */
-    float roadFunc2(float x) const;
-
-    /**
-     * @brief First derivative of the first road equation for slope calculation.
-     *
-     * @param x X-coordinate input for the derivative.
-     * @return The slope of road equation 1 at the given X.
+     * @var shape_
+     * @brief Curve of the road, chosen by roadType_.
      */
-    float roadFunc1Derivative(float x) const;
+    const RoadShape* shape_;
 
     /**
-     * @brief First derivative of the second road equation for slope calculation.
-     *
-     * @param x X-coordinate input for the derivative.
-     * @return The slope of road equation 2 at the given X.
+     * @var cartDistance_
+     * @brief Distance of the cart along the road from x = 0.
      */
-    float roadFunc2Derivative(float x) const;
+    double cartDistance_;
 
 public:
     /**
@@ -80,7 +69,7 @@ public:
      * @param x X-coordinate for which to calculate the corresponding Y-coordinate.
      * @return The Y-coordinate on the road at the given X.
      */
-    float getY(float x) const;
+    float getY(float x) const { return shape_->getY(x); }
 
     /**
      * @brief Calculates the slope of the road at the given X-coordinate using the road's derivative.
@@ -88,14 +77,37 @@ public:
      * @param x X-coordinate for which to calculate the slope.
      * @return The slope of the road at the given X.
      */
-    float getSlope(float x) const;
+    float getSlope(float x) const { return shape_->getSlope(x); }
+
+    /**
+     * @brief Gets the curve of the road, e.g. to put Traffic on it.
+     *
+     * @return The road's shape.
+     */
+    const RoadShape& getShape() const { return *shape_; }
+
+    /**
+     * @brief Gets the length of the road along its curve.
+     *
+     * @return Arc length between x = 0 and x = 40.
+     */
+    float getLength() const { return static_cast<float>(shape_->getArcLength().getLength()); }
+
+    /**
+     * @brief Gets how far along the road the cart is.
+     *
+     * @return Arc length from x = 0 to the cart.
+     */
+    float getCartDistance() const { return static_cast<float>(cartDistance_); }
 
     /**
      * @brief Draws the road on the screen.
      *
      * This method is responsible for rendering the road according to its type.
+     *
+     * @param context The render context to draw into.
      */
-    void draw() const;
+    void draw(RenderContext& context) const;
 
     /**
      * @brief Creates a cart on the road at the specified position, orientation, and scale.
@@ -110,16 +122,39 @@ public:
     /**
      * @brief Moves the cart along the road at the given speed.
      *
-     * @param speed Speed at which the cart should move.
+     * The cart covers exactly that distance along the curve, turning around at either end of the road
+     * (as often as the step requires) and continuing with the rest of the step.
+     *
+     * @param speed Distance the cart travels in this step.
      */
     void moveCart(float speed);
 
+    /**
+     * @brief Puts the cart at a point along the road, for a cart whose movement is worked out elsewhere.
+     *
+     * The cart is placed and oriented exactly as moveCart() would leave it at that distance and direction.
+     *
+     * @param distance Arc length from x = 0 to the cart.
+     * @param direction 1 when the cart drives right, -1 when it drives left.
+     * @param wheelAngle Rotation of the cart's wheels in degrees.
+     */
+    void setCartState(double distance, int direction, float wheelAngle);
+
     /**
      * @brief Draws the cart on the screen.
      *
      * This method is responsible for rendering the cart on the road.
+     *
+     * @param context The render context to draw into.
+     */
+    void drawCart(RenderContext& context) const;
+
+    /**
+     * @brief Gets the cart driving on the road.
+     *
+     * @return The cart, or nullptr if createCart() hasn't been called.
      */
-    void drawCart() const;
+    Cart* getCart() const { return cart_.get(); }
 
     /**
      * @brief Flips the direction of the cart's movement.
@@ -127,6 +162,26 @@ public:
      * Changes the cart's movement direction from left to right or vice versa.
      */
     void flipCartDirection();
+
+    /**
+     * @brief Describes the road and its cart for a scene file.
+     *
+     * @return The road type, the cart's direction and the cart's placement.
+     */
+    RoadRecord toRecord() const;
+
+    /**
+     * @brief Restores the road and its cart from a scene file.
+     *
+     * @param record The stored road; an unknown road type gives the flat road, as in the constructor.
+     */
+    void restore(const RoadRecord& record);
+
+private:
+    /**
+     * @brief Places and orients the cart from its distance along the road and its direction.
+     */
+    void placeCart();
 };
 
 #endif // ROAD_H
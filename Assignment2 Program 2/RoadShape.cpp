@@ -0,0 +1,32 @@
+#include "RoadShape.h"
+
+namespace {
+    // Resolution of the arc-length tables
+    const int ARC_LENGTH_INTERVALS = 1024;
+}
+
+RoadShape::RoadShape(const std::function<float(float)>& height, const std::function<double(double)>& slope)
+    : arcLength_(START_X, END_X, ARC_LENGTH_INTERVALS, slope) {
+    for (float x = START_X; x <= END_X; x += POLYLINE_STEP) {
+        polyline_.push_back(x);
+        polyline_.push_back(height(x));
+    }
+}
+
+// Built on first use; function-local statics are initialized once even with several threads
+const RoadShape& RoadShape::forType(int roadType) {
+    switch (roadType) {
+    case 1: {
+        static const RoadShapeOf<SineRoad> sine;
+        return sine;
+    }
+    case 2: {
+        static const RoadShapeOf<HillRoad> hill;
+        return hill;
+    }
+    default: {
+        static const RoadShapeOf<FlatRoad> flat;  // Default flat road if no valid road type is specified
+        return flat;
+    }
+    }
+}
@@ -0,0 +1,238 @@
+#ifndef ROADSHAPE_H
+#define ROADSHAPE_H
+
+#include <cstddef>
+#include <vector>
+#include "ArcLengthTable.h"
+#include "Dual.h"
+
+/**
+ * @struct SineRoad
+ * @brief Road type 1: a sine wave around y = 2.
+ */
+struct SineRoad {
+    /**
+     * @brief Height of the road.
+     *
+     * @tparam T float, or Dual<float> to get the slope as well.
+     * @param x X-coordinate on the road.
+     * @return The Y-coordinate of the road at x.
+     */
+    template <class T>
+    static T height(T x) {
+        using std::sin;
+        return sin(x) + T(2.0f);
+    }
+};
+
+/**
+ * @struct HillRoad
+ * @brief Road type 2: one big hill peaking at (20, 20).
+ */
+struct HillRoad {
+    /**
+     * @brief Height of the road.
+     *
+     * @tparam T float, or Dual<float> to get the slope as well.
+     * @param x X-coordinate on the road.
+     * @return The Y-coordinate of the road at x.
+     */
+    template <class T>
+    static T height(T x) {
+        return T(-0.05f) * (x - T(20.0f)) * (x - T(20.0f)) + T(20.0f);
+    }
+};
+
+/**
+ * @struct FlatRoad
+ * @brief Any other road type: flat along y = 0.
+ */
+struct FlatRoad {
+    /**
+     * @brief Height of the road.
+     *
+     * @tparam T float, or Dual<float> to get the slope as well.
+     * @param x X-coordinate on the road.
+     * @return Always 0.
+     */
+    template <class T>
+    static T height(T /*x*/) {
+        return T(0.0f);
+    }
+};
+
+/**
+ * @class RoadShape
+ * @brief Type-erased road curve: the one place where the curve of a Road is chosen at run time.
+ *
+ * Each road type is a policy struct with a templated height(); RoadShapeOf instantiates it, so
+ * the height and the slope (derived automatically with dual numbers) are inlined where they are
+ * evaluated. Everything that evaluates many points takes them all in one call, so a loop over
+ * the points runs without branches or indirect calls, and only the call itself is virtual.
+ *
+ * Shapes are immutable singletons shared by every road of the same type, together with the road's
+ * arc-length table and the polyline it is drawn with, both computed once when the shape is created.
+ *
+ * @author Harrison Grenier
+ */
+class RoadShape {
+public:
+    /**
+     * @brief Extent of the world the road is laid over.
+     */
+    static constexpr float START_X = 0.0f, END_X = 40.0f;
+
+    /**
+     * @brief Distance in x between the points of the polyline.
+     */
+    static constexpr float POLYLINE_STEP = 0.1f;
+
+    virtual ~RoadShape() = default;
+
+    /**
+     * @brief Gets the shape of a road type.
+     *
+     * @param roadType 1 for the sine wave, 2 for the hill, anything else for the flat road.
+     * @return The shape, which lives for the rest of the program.
+     */
+    static const RoadShape& forType(int roadType);
+
+    /**
+     * @brief Returns the Y-coordinate of the road at a given X-coordinate.
+     *
+     * @param x X-coordinate on the road.
+     * @return The Y-coordinate on the road at x.
+     */
+    virtual float getY(float x) const = 0;
+
+    /**
+     * @brief Calculates the slope of the road at a given X-coordinate.
+     *
+     * @param x X-coordinate on the road.
+     * @return The slope dy/dx at x.
+     */
+    virtual float getSlope(float x) const = 0;
+
+    /**
+     * @brief Gets the height and slope of the road together, in one evaluation.
+     *
+     * @param x X-coordinate on the road.
+     * @param y Receives the Y-coordinate at x.
+     * @param slope Receives the slope dy/dx at x.
+     */
+    virtual void evaluate(float x, float& y, float& slope) const = 0;
+
+    /**
+     * @brief Gets the height of the road at many points.
+     *
+     * @param xs X-coordinates on the road.
+     * @param ys Receives the Y-coordinate at every x.
+     * @param count Number of points.
+     */
+    virtual void getY(const float* xs, float* ys, size_t count) const = 0;
+
+    /**
+     * @brief Gets the height and slope of the road at many points.
+     *
+     * @param xs X-coordinates on the road.
+     * @param ys Receives the Y-coordinate at every x.
+     * @param slopes Receives the slope dy/dx at every x.
+     * @param count Number of points.
+     */
+    virtual void evaluate(const float* xs, float* ys, float* slopes, size_t count) const = 0;
+
+    /**
+     * @brief Gets the arc-length table of the road between START_X and END_X.
+     *
+     * @return The table.
+     */
+    const ArcLengthTable& getArcLength() const { return arcLength_; }
+
+    /**
+     * @brief Gets the road sampled as a line strip, every POLYLINE_STEP from START_X to END_X.
+     *
+     * @return Interleaved x, y coordinates of the points.
+     */
+    const std::vector<float>& getPolyline() const { return polyline_; }
+
+protected:
+    /**
+     * @brief Samples a curve and builds its arc-length table.
+     *
+     * @param height The curve.
+     * @param slope Derivative of the curve.
+     */
+    RoadShape(const std::function<float(float)>& height, const std::function<double(double)>& slope);
+
+private:
+    /**
+     * @var arcLength_
+     * @brief Arc-length table of the road.
+     */
+    ArcLengthTable arcLength_;
+
+    /**
+     * @var polyline_
+     * @brief Interleaved x, y coordinates of the sampled road.
+     */
+    std::vector<float> polyline_;
+};
+
+/**
+ * @class RoadShapeOf
+ * @brief RoadShape of a road type policy, with the policy inlined into every evaluation.
+ *
+ * @tparam Curve Policy with a static template height(T x), such as SineRoad.
+ *
+ * @author Harrison Grenier
+ */
+template <class Curve>
+class RoadShapeOf final : public RoadShape {
+public:
+    /**
+     * @brief Samples the curve and builds its arc-length table.
+     */
+    RoadShapeOf() : RoadShape(height, [](double x) { return slope(static_cast<float>(x)); }) {}
+
+    /**
+     * @brief Height of the curve, without a virtual call.
+     *
+     * @param x X-coordinate on the road.
+     * @return The Y-coordinate on the road at x.
+     */
+    static float height(float x) { return Curve::height(x); }
+
+    /**
+     * @brief Slope of the curve, without a virtual call.
+     *
+     * @param x X-coordinate on the road.
+     * @return The slope dy/dx at x.
+     */
+    static float slope(float x) { return Curve::height(Dual<float>::variable(x)).derivative; }
+
+    float getY(float x) const override { return height(x); }
+
+    float getSlope(float x) const override { return slope(x); }
+
+    void evaluate(float x, float& y, float& slope) const override {
+        Dual<float> result = Curve::height(Dual<float>::variable(x));
+        y = result.value;
+        slope = result.derivative;
+    }
+
+    void getY(const float* xs, float* ys, size_t count) const override {
+        for (size_t i = 0; i < count; i++) {
+            ys[i] = height(xs[i]);
+        }
+    }
+
+    void evaluate(const float* xs, float* ys, float* slopes, size_t count) const override {
+        for (size_t i = 0; i < count; i++) {
+            Dual<float> result = Curve::height(Dual<float>::variable(xs[i]));
+            ys[i] = result.value;
+            slopes[i] = result.derivative;
+        }
+    }
+};
+
+#endif // ROADSHAPE_H
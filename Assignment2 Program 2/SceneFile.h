@@ -0,0 +1,203 @@
+#ifndef SCENEFILE_H
+#define SCENEFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @enum SceneSectionType
+ * @brief Kinds of record a scene file can hold, one section per kind.
+ */
+enum class SceneSectionType : uint32_t {
+    WHEELS = 1, /**< WheelRecord entries */
+    ROADS = 2   /**< RoadRecord entries */
+};
+
+/**
+ * @struct WheelRecord
+ * @brief Stored form of a PortraitWheel.
+ */
+struct WheelRecord {
+    float x;              /**< X-coordinate of the wheel's center */
+    float y;              /**< Y-coordinate of the wheel's center */
+    float orientation;    /**< Rotation of the wheel in degrees */
+    uint8_t type;         /**< WheelType as an integer */
+    uint8_t size;         /**< WheelSize as an integer */
+    uint8_t numPortraits; /**< Number of portraits on the wheel */
+    uint8_t reserved;     /**< Always 0 */
+};
+
+/**
+ * @struct RoadRecord
+ * @brief Stored form of a Road and the state of its cart.
+ */
+struct RoadRecord {
+    int32_t roadType;       /**< Road equation selector */
+    int32_t cartDirection;  /**< 1 when the cart drives right, -1 when it drives left */
+    uint32_t hasCart;       /**< 1 if the remaining fields describe a cart */
+    float cartX;            /**< X-coordinate of the cart */
+    float cartY;            /**< Y-coordinate of the cart */
+    float cartOrientation;  /**< Rotation of the cart in degrees */
+    float cartScale;        /**< Size factor the cart was created with */
+    float cartWheelAngle;   /**< Rotation of the cart's wheels in degrees */
+    double cartDistance;    /**< Distance of the cart along the road, which its position is derived from */
+};
+
+static_assert(sizeof(WheelRecord) == 16, "WheelRecord is part of the file format");
+static_assert(sizeof(RoadRecord) == 40, "RoadRecord is part of the file format");
+
+/**
+ * @class SceneFile
+ * @brief Versioned binary scene format, read through a read-only memory mapping.
+ *
+ * A file is a header (magic "A2SCENE", version, section count), a table of sections (type, record
+ * size, offset, record count) and the record arrays, each aligned to 8 bytes. Opening a file only
+ * maps it and checks the header and table, so the records can be used in place without being
+ * parsed or copied; a million-record file opens as quickly as an empty one.
+ *
+ * Records are stored in the machine's own (little-endian) layout. Readers reject files with a
+ * newer version, and sections whose record size doesn't match the structure they are read as.
+ *
+ * @note Pointers returned by getSection() are valid until close() or destruction.
+ *
+ * @author Harrison Grenier
+ */
+class SceneFile {
+public:
+    /**
+     * @struct SectionData
+     * @brief One section to write: an array of records of a single type.
+     */
+    struct SectionData {
+        SceneSectionType type; /**< Kind of the records */
+        uint32_t recordSize;   /**< Size of one record in bytes */
+        const void* records;   /**< The first record */
+        uint64_t count;        /**< Number of records */
+    };
+
+    /**
+     * @brief Describes a vector of records as a section to write.
+     *
+     * @param type Kind of the records.
+     * @param records The records.
+     * @return The section description, referring to the vector's storage.
+     */
+    template <typename Record>
+    static SectionData section(SceneSectionType type, const std::vector<Record>& records) {
+        return { type, static_cast<uint32_t>(sizeof(Record)), records.data(), records.size() };
+    }
+
+    /**
+     * @brief Writes a scene file, replacing any existing file.
+     *
+     * @param path Path of the file.
+     * @param sections The sections to store.
+     * @return True on success.
+     */
+    static bool write(const std::string& path, const std::vector<SectionData>& sections);
+
+    /**
+     * @brief Constructs a closed scene file.
+     */
+    SceneFile();
+
+    /**
+     * @brief Unmaps the file if it is open.
+     */
+    ~SceneFile();
+
+    SceneFile(const SceneFile&) = delete;
+    SceneFile& operator=(const SceneFile&) = delete;
+
+    /**
+     * @brief Maps a scene file and validates its header and section table.
+     *
+     * @param path Path of the file.
+     * @return True on success; otherwise getError() tells why.
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Unmaps the file. Does nothing if it isn't open.
+     */
+    void close();
+
+    /**
+     * @brief Gets the records of a section in place.
+     *
+     * @param type Kind of the section.
+     * @param count Receives the number of records, 0 if the section is missing or doesn't match.
+     * @return The first record, or nullptr if there are none.
+     */
+    template <typename Record>
+    const Record* getSection(SceneSectionType type, size_t& count) const {
+        return static_cast<const Record*>(findSection(type, sizeof(Record), count));
+    }
+
+    /**
+     * @brief Gets the version of the open file.
+     *
+     * @return The version, 0 if no file is open.
+     */
+    uint32_t getVersion() const;
+
+    /**
+     * @brief Gets the reason the last open() failed.
+     *
+     * @return The message, empty after a successful open.
+     */
+    const std::string& getError() const { return error_; }
+
+    /**
+     * @var VERSION
+     * @brief Version written by this code; files up to this version can be read.
+     */
+    static const uint32_t VERSION = 1;
+
+private:
+    /**
+     * @brief Looks up a section and checks its record size.
+     *
+     * @param type Kind of the section.
+     * @param recordSize Expected size of one record.
+     * @param count Receives the number of records.
+     * @return The section's records, or nullptr.
+     */
+    const void* findSection(SceneSectionType type, size_t recordSize, size_t& count) const;
+
+    /**
+     * @brief Records why opening failed and unmaps the file.
+     *
+     * @param message The reason.
+     * @return Always false.
+     */
+    bool fail(const std::string& message);
+
+    /**
+     * @var data_
+     * @brief Start of the mapping, or nullptr when closed.
+     */
+    const unsigned char* data_;
+
+    /**
+     * @var size_
+     * @brief Size of the mapping in bytes.
+     */
+    size_t size_;
+
+    /**
+     * @var mapping_
+     * @brief Platform handle of the mapping (the file mapping object on Windows, unused elsewhere).
+     */
+    void* mapping_;
+
+    /**
+     * @var error_
+     * @brief Reason the last open() failed.
+     */
+    std::string error_;
+};
+
+#endif // SCENEFILE_H
@@ -0,0 +1,321 @@
+#include "SoftwareRasterizer.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+
+namespace {
+    uint8_t toByte(float c) {
+        c = std::min(1.0f, std::max(0.0f, c));
+        return static_cast<uint8_t>(c * 255.0f + 0.5f);
+    }
+
+    // PNG chunk CRC (ISO 3309 / ITU-T V.42 polynomial)
+    uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+        static uint32_t table[256];
+        static bool tableReady = [] {
+            for (uint32_t n = 0; n < 256; n++) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++) {
+                    c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+                }
+                table[n] = c;
+            }
+            return true;
+        }();
+        (void)tableReady;
+
+        crc = ~crc;
+        for (size_t i = 0; i < length; i++) {
+            crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    void putBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void writeChunk(std::ofstream& file, const char* type, const std::vector<uint8_t>& data) {
+        std::vector<uint8_t> chunk;
+        putBigEndian(chunk, static_cast<uint32_t>(data.size()));
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), data.begin(), data.end());
+        putBigEndian(chunk, crc32(chunk.data() + 4, chunk.size() - 4));  // CRC covers type and data
+        file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    }
+}
+
+SoftwareRasterizer::SoftwareRasterizer(int width, int height, float xMin, float xMax, float yMin, float yMax,
+                                       unsigned int threadCount)
+    : width_(width), height_(height), xMin_(xMin), yMax_(yMax),
+    pixelsPerUnitX_(width / (xMax - xMin)), pixelsPerUnitY_(height / (yMax - yMin)),
+    tilesX_((width + TILE_SIZE - 1) / TILE_SIZE), tilesY_((height + TILE_SIZE - 1) / TILE_SIZE),
+    clear_{ 0, 0, 0 }, pixels_(static_cast<size_t>(width) * height * 3, 0), pool_(threadCount) {
+    setPixelsPerUnit(std::min(pixelsPerUnitX_, pixelsPerUnitY_));
+    setViewBounds({ xMin, yMin, xMax, yMax });
+    bins_.resize(pool_.getThreadCount());
+    for (auto& chunkBins : bins_) {
+        chunkBins.resize(static_cast<size_t>(tilesX_) * tilesY_);
+    }
+}
+
+void SoftwareRasterizer::beginFrame(float r, float g, float b) {
+    triangles_.clear();
+    resetMatrix();
+    clear_[0] = toByte(r);
+    clear_[1] = toByte(g);
+    clear_[2] = toByte(b);
+}
+
+void SoftwareRasterizer::emitTriangle(const GeometryVertex& a, const GeometryVertex& b, const GeometryVertex& c,
+                                      const GeometryColor& color) {
+    // World to pixels, with the image's y axis pointing down
+    addScreenTriangle((a.x - xMin_) * pixelsPerUnitX_, (yMax_ - a.y) * pixelsPerUnitY_,
+                      (b.x - xMin_) * pixelsPerUnitX_, (yMax_ - b.y) * pixelsPerUnitY_,
+                      (c.x - xMin_) * pixelsPerUnitX_, (yMax_ - c.y) * pixelsPerUnitY_, color);
+}
+
+void SoftwareRasterizer::emitLine(const GeometryVertex& a, const GeometryVertex& b, const GeometryColor& color) {
+    float x0 = (a.x - xMin_) * pixelsPerUnitX_, y0 = (yMax_ - a.y) * pixelsPerUnitY_;
+    float x1 = (b.x - xMin_) * pixelsPerUnitX_, y1 = (yMax_ - b.y) * pixelsPerUnitY_;
+
+    // Offset both ends half a pixel along the normal to get a one-pixel-wide quad
+    float dx = x1 - x0, dy = y1 - y0;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) {
+        return;
+    }
+    float nx = -dy / length * 0.5f, ny = dx / length * 0.5f;
+    addScreenTriangle(x0 + nx, y0 + ny, x1 + nx, y1 + ny, x1 - nx, y1 - ny, color);
+    addScreenTriangle(x0 + nx, y0 + ny, x1 - nx, y1 - ny, x0 - nx, y0 - ny, color);
+}
+
+void SoftwareRasterizer::addScreenTriangle(float x0, float y0, float x1, float y1, float x2, float y2,
+                                           const GeometryColor& color) {
+    // Make the winding consistent so the edge functions are positive inside
+    float area = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+    if (area == 0.0f) {
+        return;
+    }
+    if (area < 0.0f) {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+    }
+
+    ScreenTriangle t;
+    t.x[0] = x0; t.x[1] = x1; t.x[2] = x2;
+    t.y[0] = y0; t.y[1] = y1; t.y[2] = y2;
+
+    // Range of pixels whose centers (i + 0.5) can lie inside, clamped to the image
+    t.minX = std::max(0, static_cast<int>(std::ceil(std::min({ x0, x1, x2 }) - 0.5f)));
+    t.minY = std::max(0, static_cast<int>(std::ceil(std::min({ y0, y1, y2 }) - 0.5f)));
+    t.maxX = std::min(width_ - 1, static_cast<int>(std::floor(std::max({ x0, x1, x2 }) - 0.5f)));
+    t.maxY = std::min(height_ - 1, static_cast<int>(std::floor(std::max({ y0, y1, y2 }) - 0.5f)));
+    if (t.minX > t.maxX || t.minY > t.maxY) {
+        return;  // off screen or covers no pixel center
+    }
+
+    t.rgb[0] = toByte(color.r);
+    t.rgb[1] = toByte(color.g);
+    t.rgb[2] = toByte(color.b);
+    triangles_.push_back(t);
+}
+
+void SoftwareRasterizer::endFrame() {
+    size_t chunks = bins_.size();
+    size_t count = triangles_.size();
+
+    // Bin: every thread sorts one contiguous chunk of triangles into its own per-tile lists
+    pool_.parallelFor(chunks, [&](size_t chunk) {
+        std::vector<std::vector<uint32_t>>& tiles = bins_[chunk];
+        for (auto& list : tiles) {
+            list.clear();
+        }
+        size_t first = count * chunk / chunks;
+        size_t last = count * (chunk + 1) / chunks;
+        for (size_t i = first; i < last; i++) {
+            const ScreenTriangle& t = triangles_[i];
+            for (int ty = t.minY / TILE_SIZE; ty <= t.maxY / TILE_SIZE; ty++) {
+                for (int tx = t.minX / TILE_SIZE; tx <= t.maxX / TILE_SIZE; tx++) {
+                    tiles[static_cast<size_t>(ty) * tilesX_ + tx].push_back(static_cast<uint32_t>(i));
+                }
+            }
+        }
+    });
+
+    // Rasterize: tiles are independent, so they can be filled in any order on any thread
+    pool_.parallelFor(static_cast<size_t>(tilesX_) * tilesY_, [this](size_t tile) { rasterizeTile(tile); });
+}
+
+void SoftwareRasterizer::rasterizeTile(size_t tile) {
+    int tileX0 = static_cast<int>(tile % tilesX_) * TILE_SIZE;
+    int tileY0 = static_cast<int>(tile / tilesX_) * TILE_SIZE;
+    int tileX1 = std::min(tileX0 + TILE_SIZE, width_) - 1;
+    int tileY1 = std::min(tileY0 + TILE_SIZE, height_) - 1;
+
+    // Clear the tile
+    for (int y = tileY0; y <= tileY1; y++) {
+        uint8_t* row = &pixels_[(static_cast<size_t>(y) * width_ + tileX0) * 3];
+        for (int x = tileX0; x <= tileX1; x++, row += 3) {
+            row[0] = clear_[0];
+            row[1] = clear_[1];
+            row[2] = clear_[2];
+        }
+    }
+
+    // Draw the tile's triangles in submission order (chunk by chunk)
+    for (const auto& chunkBins : bins_) {
+        for (uint32_t index : chunkBins[tile]) {
+            const ScreenTriangle& t = triangles_[index];
+            int minX = std::max(t.minX, tileX0), maxX = std::min(t.maxX, tileX1);
+            int minY = std::max(t.minY, tileY0), maxY = std::min(t.maxY, tileY1);
+
+            // Edge functions, evaluated at the first pixel center and stepped incrementally
+            float px = minX + 0.5f, py = minY + 0.5f;
+            float e[3], stepX[3], stepY[3];
+            for (int k = 0; k < 3; k++) {
+                int k1 = (k + 1) % 3, k2 = (k + 2) % 3;
+                float ax = t.x[k1], ay = t.y[k1], bx = t.x[k2], by = t.y[k2];
+                e[k] = (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+                stepX[k] = -(by - ay);
+                stepY[k] = bx - ax;
+            }
+
+            for (int y = minY; y <= maxY; y++) {
+                float w0 = e[0], w1 = e[1], w2 = e[2];
+                uint8_t* out = &pixels_[(static_cast<size_t>(y) * width_ + minX) * 3];
+                for (int x = minX; x <= maxX; x++, out += 3) {
+                    if (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f) {
+                        out[0] = t.rgb[0];
+                        out[1] = t.rgb[1];
+                        out[2] = t.rgb[2];
+                    }
+                    w0 += stepX[0];
+                    w1 += stepX[1];
+                    w2 += stepX[2];
+                }
+                e[0] += stepY[0];
+                e[1] += stepY[1];
+                e[2] += stepY[2];
+            }
+        }
+    }
+}
+
+bool SoftwareRasterizer::writePPM(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    file << "P6\n" << width_ << " " << height_ << "\n255\n";
+    file.write(reinterpret_cast<const char*>(pixels_.data()), pixels_.size());
+    return static_cast<bool>(file);
+}
+
+bool SoftwareRasterizer::writePNG(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+    file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+
+    // IHDR: size, 8 bits per channel, RGB, default compression/filter, no interlace
+    std::vector<uint8_t> header;
+    putBigEndian(header, static_cast<uint32_t>(width_));
+    putBigEndian(header, static_cast<uint32_t>(height_));
+    header.insert(header.end(), { 8, 2, 0, 0, 0 });
+    writeChunk(file, "IHDR", header);
+
+    // Scanlines, each preceded by filter type 0 (none)
+    size_t rowBytes = static_cast<size_t>(width_) * 3;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height_);
+    for (int y = 0; y < height_; y++) {
+        raw.push_back(0);
+        raw.insert(raw.end(), pixels_.begin() + y * rowBytes, pixels_.begin() + (y + 1) * rowBytes);
+    }
+
+    // zlib stream made of stored (uncompressed) deflate blocks
+    std::vector<uint8_t> zlib = { 0x78, 0x01 };
+    const size_t MAX_BLOCK = 65535;
+    for (size_t offset = 0; offset < raw.size() || offset == 0; offset += MAX_BLOCK) {
+        size_t length = std::min(MAX_BLOCK, raw.size() - offset);
+        bool last = offset + length >= raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back(static_cast<uint8_t>(length));
+        zlib.push_back(static_cast<uint8_t>(length >> 8));
+        zlib.push_back(static_cast<uint8_t>(~length));
+        zlib.push_back(static_cast<uint8_t>(~length >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+        if (last) {
+            break;
+        }
+    }
+    uint32_t s1 = 1, s2 = 0;  // Adler-32 of the uncompressed data
+    for (uint8_t byte : raw) {
+        s1 = (s1 + byte) % 65521;
+        s2 = (s2 + s1) % 65521;
+    }
+    putBigEndian(zlib, (s2 << 16) | s1);
+    writeChunk(file, "IDAT", zlib);
+    writeChunk(file, "IEND", {});
+    return static_cast<bool>(file);
+}
+
+bool SoftwareRasterizer::writeImage(const std::string& path) const {
+    const std::string extension = ".png";
+    if (path.size() >= extension.size() &&
+        path.compare(path.size() - extension.size(), extension.size(), extension) == 0) {
+        return writePNG(path);
+    }
+    return writePPM(path);
+}
+
+bool SoftwareRasterizer::formatFramePath(const std::string& pattern, int frame, std::string& path) {
+    const size_t MAX_WIDTH = 32;
+    path.clear();
+    bool converted = false;
+    for (size_t i = 0; i < pattern.size(); i++) {
+        if (pattern[i] != '%') {
+            path += pattern[i];
+            continue;
+        }
+        if (i + 1 < pattern.size() && pattern[i + 1] == '%') {
+            path += '%';
+            i++;
+            continue;
+        }
+
+        // "%" [ "0" ] [ width ] "d", and only once
+        size_t end = i + 1;
+        bool zeroPad = end < pattern.size() && pattern[end] == '0';
+        if (zeroPad) {
+            end++;
+        }
+        size_t width = 0;
+        while (end < pattern.size() && std::isdigit(static_cast<unsigned char>(pattern[end]))) {
+            width = width * 10 + static_cast<size_t>(pattern[end] - '0');
+            if (width > MAX_WIDTH) {
+                return false;
+            }
+            end++;
+        }
+        if (converted || end >= pattern.size() || pattern[end] != 'd') {
+            return false;
+        }
+
+        std::string number = std::to_string(frame);
+        if (number.size() < width) {
+            number.insert(0, width - number.size(), zeroPad ? '0' : ' ');
+        }
+        path += number;
+        converted = true;
+        i = end;
+    }
+    return converted;
+}
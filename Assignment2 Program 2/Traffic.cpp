@@ -0,0 +1,318 @@
+#define _USE_MATH_DEFINES
+
+#include "Traffic.h"
+#include "UnitCircle.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+namespace {
+    const float DEGREES_PER_RADIAN = 180.0f / static_cast<float>(M_PI);
+
+    // Appends count points, transformed, to a vertex buffer
+    void appendTransformed(std::vector<float>& buffer, const Affine2D& m, const float* points, size_t count) {
+        size_t start = buffer.size();
+        buffer.resize(start + 2 * count);
+        m.transformPoints(points, &buffer[start], count);
+    }
+}
+
+Traffic::Traffic(const RoadShape& shape, float scale)
+    : shape_(&shape), cartWidth_(3.0f * scale), cartHeight_(1.5f * scale), wheelRadius_(0.5f * scale),
+      response_(CollisionResponse::NONE), collisionCount_(0) {
+}
+
+size_t Traffic::addCart(double distance, float speed, bool movingLeft) {
+    size_t i = size();
+    distance_.push_back(std::min(std::max(distance, 0.0), shape_->getArcLength().getLength()));
+    direction_.push_back(movingLeft ? -1.0f : 1.0f);
+    speed_.push_back(speed);
+    wheelAngle_.push_back(0.0f);
+    x_.push_back(0.0f);
+    y_.push_back(0.0f);
+    orientation_.push_back(0.0f);
+    placeRange(i, i + 1);
+    previousX_.push_back(x_[i]);  // nothing to blend from yet
+    previousY_.push_back(y_[i]);
+    previousOrientation_.push_back(orientation_[i]);
+
+    // Insert after any cart at the same distance, so the order stays sorted; without collisions the
+    // order isn't kept, and setCollisionResponse() sorts it when it is needed again
+    if (response_ == CollisionResponse::NONE) {
+        order_.push_back(i);
+    }
+    else {
+        auto nearer = [this](double distance, size_t j) { return distance < distance_[j]; };
+        order_.insert(std::upper_bound(order_.begin(), order_.end(), distance_[i], nearer), i);
+    }
+    return i;
+}
+
+void Traffic::clear() {
+    distance_.clear();
+    direction_.clear();
+    speed_.clear();
+    wheelAngle_.clear();
+    x_.clear();
+    y_.clear();
+    orientation_.clear();
+    previousX_.clear();
+    previousY_.clear();
+    previousOrientation_.clear();
+    order_.clear();
+    collisionCount_ = 0;
+}
+
+void Traffic::reserve(size_t count) {
+    distance_.reserve(count);
+    direction_.reserve(count);
+    speed_.reserve(count);
+    wheelAngle_.reserve(count);
+    x_.reserve(count);
+    y_.reserve(count);
+    orientation_.reserve(count);
+    previousX_.reserve(count);
+    previousY_.reserve(count);
+    previousOrientation_.reserve(count);
+    order_.reserve(count);
+}
+
+void Traffic::setCollisionResponse(CollisionResponse response) {
+    if (response_ == CollisionResponse::NONE && response != CollisionResponse::NONE) {
+        // The carts may have passed each other in any way since the order was last kept
+        std::stable_sort(order_.begin(), order_.end(), [this](size_t a, size_t b) { return distance_[a] < distance_[b]; });
+    }
+    response_ = response;
+    collisionCount_ = 0;
+}
+
+void Traffic::step() {
+    stepBlocks(nullptr);
+}
+
+void Traffic::step(ThreadPool& pool) {
+    stepBlocks(&pool);
+}
+
+void Traffic::stepBlocks(ThreadPool* pool) {
+    auto forEachBlock = [this, pool](const std::function<void(size_t, size_t)>& task) {
+        size_t blocks = (size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        auto runBlock = [this, &task](size_t block) {
+            size_t first = block * BLOCK_SIZE;
+            task(first, std::min(first + BLOCK_SIZE, size()));
+        };
+        if (pool != nullptr) {
+            pool->parallelFor(blocks, runBlock);
+        }
+        else {
+            for (size_t block = 0; block < blocks; block++) {
+                runBlock(block);
+            }
+        }
+    };
+
+    if (response_ == CollisionResponse::NONE) {
+        // Nothing to wait for between moving and placing, so each block is done while it's in cache
+        forEachBlock([this](size_t first, size_t last) {
+            moveRange(first, last);
+            placeRange(first, last);
+        });
+        return;
+    }
+
+    // Collisions need every cart moved before any is placed
+    forEachBlock([this](size_t first, size_t last) { moveRange(first, last); });
+    sortByDistance();
+    resolveCollisions();
+    forEachBlock([this](size_t first, size_t last) { placeRange(first, last); });
+}
+
+// Same arithmetic as Road::moveCart and Cart::rotateWheels, so a cart here follows the same path bit for bit
+void Traffic::moveRange(size_t first, size_t last) {
+    double length = shape_->getArcLength().getLength();
+    double period = 2.0 * length;
+    size_t count = last - first;
+    double* distance = &distance_[first];
+    float* direction = &direction_[first];
+    const float* speed = &speed_[first];
+    float* wheelAngle = &wheelAngle_[first];
+
+    // Travel along the road unfolded at both ends, then fold the position back onto it
+    for (size_t i = 0; i < count; i++) {
+        double travelled = distance[i] + direction[i] * speed[i];
+        if (travelled < 0.0 || travelled >= period) {  // only steps longer than the road get this far
+            travelled = std::fmod(travelled, period);
+            if (travelled < 0.0) {
+                travelled += period;
+            }
+        }
+        bool turnedAround = travelled > length;
+        distance[i] = turnedAround ? period - travelled : travelled;
+        direction[i] = turnedAround ? -direction[i] : direction[i];
+    }
+
+    // Turn the wheels by the distance covered, backwards when driving left (direction is -1)
+    for (size_t i = 0; i < count; i++) {
+        float angularSpeed = (speed[i] / wheelRadius_ / wheelRadius_) * DEGREES_PER_RADIAN;
+        float angle = wheelAngle[i] + angularSpeed * direction[i];
+        angle -= angle >= 360.0f ? 360.0f : 0.0f;  // Keep the angle within the 0-360 range
+        angle += angle < 0.0f ? 360.0f : 0.0f;
+        wheelAngle[i] = angle;
+    }
+}
+
+// Carts rarely change places in one step, so this is a pass over the carts plus one shift per overtake
+void Traffic::sortByDistance() {
+    for (size_t i = 1; i < order_.size(); i++) {
+        size_t cart = order_[i];
+        double distance = distance_[cart];
+        size_t j = i;
+        for (; j > 0 && distance_[order_[j - 1]] > distance; j--) {
+            order_[j] = order_[j - 1];
+        }
+        order_[j] = cart;
+    }
+}
+
+// Sweep along the road: a cart can only overlap the next one in order before it overlaps any further one
+void Traffic::resolveCollisions() {
+    double length = shape_->getArcLength().getLength();
+    double width = cartWidth_;
+    collisionCount_ = 0;
+
+    for (size_t k = 0; k + 1 < order_.size(); k++) {
+        size_t behind = order_[k], ahead = order_[k + 1];
+        if (distance_[ahead] - distance_[behind] >= width) {
+            continue;
+        }
+        collisionCount_++;
+
+        // Push the cart ahead out of the way, by the overlap; if that makes it overlap the next cart,
+        // that pair is next in the sweep, which pushes the next cart on, so the order holds
+        distance_[ahead] = distance_[behind] + width;
+
+        // Velocities along the road; only carts closing in on each other respond
+        float behindVelocity = direction_[behind] * speed_[behind];
+        float aheadVelocity = direction_[ahead] * speed_[ahead];
+        if (behindVelocity <= aheadVelocity) {
+            continue;
+        }
+        switch (response_) {
+        case CollisionResponse::STOP:
+            speed_[behind] = speed_[ahead] = 0.0f;
+            break;
+        case CollisionResponse::FOLLOW:
+            if (behindVelocity > 0.0f && aheadVelocity >= 0.0f) {  // caught up from behind, driving right
+                direction_[behind] = direction_[ahead];
+                speed_[behind] = speed_[ahead];
+            }
+            else if (aheadVelocity < 0.0f && behindVelocity <= 0.0f) {  // caught up from behind, driving left
+                direction_[ahead] = direction_[behind];
+                speed_[ahead] = speed_[behind];
+            }
+            else {  // head-on, with nobody to follow: bounce
+                std::swap(direction_[behind], direction_[ahead]);
+                std::swap(speed_[behind], speed_[ahead]);
+            }
+            break;
+        case CollisionResponse::BOUNCE:
+            std::swap(direction_[behind], direction_[ahead]);
+            std::swap(speed_[behind], speed_[ahead]);
+            break;
+        case CollisionResponse::NONE:
+            break;
+        }
+    }
+
+    // Carts pushed past the right end go back, each pulling back the one before it if they touch;
+    // only when the road is too full for every cart does the first one end up overlapping at the left end
+    for (size_t k = order_.size(); k > 0; k--) {
+        double limit = k == order_.size() ? length : distance_[order_[k]] - width;
+        double& distance = distance_[order_[k - 1]];
+        if (distance <= limit) {
+            break;
+        }
+        distance = std::max(limit, 0.0);
+    }
+}
+
+void Traffic::placeRange(size_t first, size_t last) {
+    const ArcLengthTable& arcLength = shape_->getArcLength();
+    for (size_t i = first; i < last; i++) {
+        x_[i] = static_cast<float>(arcLength.xAt(distance_[i]));
+    }
+
+    // Heights and slopes of the whole block in one call; the slopes wait in orientation_ to become angles
+    shape_->evaluate(&x_[first], &y_[first], &orientation_[first], last - first);
+    for (size_t i = first; i < last; i++) {
+        float angle = std::atan(orientation_[i]) * DEGREES_PER_RADIAN;
+        orientation_[i] = direction_[i] < 0.0f ? angle + 180.0f : angle;  // keep the cart upright but facing left
+    }
+}
+
+void Traffic::capture() {
+    previousX_ = x_;
+    previousY_ = y_;
+    previousOrientation_ = orientation_;
+}
+
+// Builds the same shapes as Cart::draw, already transformed, into one buffer per primitive type
+void Traffic::draw(RenderContext& context, float alpha) const {
+    float halfWidth = cartWidth_ / 2, halfHeight = cartHeight_ / 2;
+    const float body[8] = { -halfWidth, -halfHeight, halfWidth, -halfHeight, halfWidth, halfHeight, -halfWidth, halfHeight };
+    const float nose[6] = { halfWidth, halfHeight, halfWidth + 0.5f, 0.0f, halfWidth, -halfHeight };
+    const float noseLeft[6] = { -halfWidth, halfHeight, -halfWidth - 0.5f, 0.0f, -halfWidth, -halfHeight };
+
+    // A wheel as segments: its rim (one point every 30 degrees), then the spokes every 90 degrees
+    const std::vector<UnitCirclePoint>& rim = UnitCircle::get(12);
+    std::vector<float> wheel;
+    for (size_t k = 0; k < rim.size(); k++) {
+        const UnitCirclePoint& next = rim[(k + 1) % rim.size()];
+        wheel.insert(wheel.end(), { wheelRadius_ * rim[k].x, wheelRadius_ * rim[k].y, wheelRadius_ * next.x, wheelRadius_ * next.y });
+    }
+    for (size_t k = 0; k < rim.size(); k += 3) {
+        wheel.insert(wheel.end(), { 0.0f, 0.0f, wheelRadius_ * rim[k].x, wheelRadius_ * rim[k].y });
+    }
+    size_t wheelPoints = wheel.size() / 2;
+
+    // Radius of a circle around every cart, whatever its orientation
+    float reach = std::hypot(std::max(halfWidth + 0.5f, cartWidth_ / 3 + wheelRadius_), halfHeight + wheelRadius_);
+    const Affine2D turnAround = Affine2D::rotation(180.0f);
+    const Affine2D wheelOffsets[2] = { Affine2D::translation(-cartWidth_ / 3, -halfHeight), Affine2D::translation(cartWidth_ / 3, -halfHeight) };
+
+    bodies_.clear();
+    noses_.clear();
+    wheels_.clear();
+    for (size_t i = 0; i < size(); i++) {
+        float x = x_[i], y = y_[i], orientation = orientation_[i];
+        if (alpha < 1.0f) {
+            x = previousX_[i] + (x - previousX_[i]) * alpha;
+            y = previousY_[i] + (y - previousY_[i]) * alpha;
+            float turn = std::remainder(orientation - previousOrientation_[i], 360.0f);
+            if (std::abs(turn) <= 90.0f) {
+                orientation -= turn * (1.0f - alpha);
+            }
+        }
+        if (!context.isVisible({ x - reach, y - reach, x + reach, y + reach })) {
+            continue;
+        }
+        bool movingLeft = direction_[i] < 0.0f;
+        Affine2D m = Affine2D::fromTransform(x, y, orientation, 1.0f);
+        if (movingLeft) {
+            m = m * turnAround;
+        }
+        appendTransformed(bodies_, m, body, 4);
+        appendTransformed(noses_, m, movingLeft ? noseLeft : nose, 3);
+
+        Affine2D spin = Affine2D::rotation(wheelAngle_[i]);
+        for (const Affine2D& offset : wheelOffsets) {
+            appendTransformed(wheels_, m * offset * spin, wheel.data(), wheelPoints);
+        }
+    }
+
+    context.setColor(0.5f, 0.5f, 0.5f);  // Gray body and nose
+    context.drawVertices(PrimitiveType::QUADS, bodies_.data(), bodies_.size() / 2);
+    context.drawVertices(PrimitiveType::TRIANGLES, noses_.data(), noses_.size() / 2);
+    context.setColor(1.0f, 1.0f, 1.0f);  // White wheels
+    context.drawVertices(PrimitiveType::LINES, wheels_.data(), wheels_.size() / 2);
+}
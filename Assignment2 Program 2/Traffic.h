@@ -0,0 +1,331 @@
+#ifndef TRAFFIC_H
+#define TRAFFIC_H
+
+#include <cstddef>
+#include <vector>
+#include "RoadShape.h"
+#include "RenderContext.h"
+#include "ThreadPool.h"
+
+/**
+ * @enum CollisionResponse
+ * @brief What carts of a Traffic do when they run into each other.
+ */
+enum class CollisionResponse {
+    NONE,   /**< Carts pass through each other, like separate Roads */
+    STOP,   /**< Both carts stop where they touch */
+    BOUNCE, /**< The carts swap speeds and directions, as in an elastic collision of equal masses */
+    FOLLOW  /**< A cart that catches up with another stays behind it at its speed; head-on carts bounce */
+};
+
+/**
+ * @class Traffic
+ * @brief Any number of carts driving along one road, stored as parallel arrays.
+ *
+ * Every cart moves exactly like the single cart of a Road: it travels its speed along the curve
+ * each step, turns around at either end, faces along the road and turns its wheels. Instead of one
+ * Cart object per cart, the state lives in one array per field (distance, direction, speed, wheel
+ * angle, and the position and orientation derived from them), so a step runs each phase as a tight
+ * loop over contiguous memory that the compiler can vectorize, and the road's curve is evaluated
+ * for a whole block of carts with a single call.
+ *
+ * step(ThreadPool&) splits the carts into fixed blocks and steps the blocks on all threads; collisions
+ * are resolved on the calling thread in between, so the results are the same with any number of threads. draw() builds the
+ * geometry of all visible carts in world space and submits it with three drawVertices() calls.
+ *
+ * With a CollisionResponse other than NONE, carts don't pass through each other. The carts are kept
+ * sorted by distance along the road; after every step an insertion sort restores the order, which
+ * costs little more than a pass over the carts since they rarely change places. A sweep then checks
+ * each cart only against the next one in that order, finds the pairs closer than a cart's width,
+ * pushes them apart and applies the response, so a step stays close to linear in the cart count.
+ * Only carts that overlap after a step are seen, so no cart should travel half a cart's width or
+ * more per step, or two carts could pass through each other within one.
+ *
+ * All carts have the same size.
+ *
+ * @author Harrison Grenier
+ */
+class Traffic {
+public:
+    /**
+     * @brief Constructs an empty road of traffic.
+     *
+     * @param shape The road the carts drive on.
+     * @param scale Size factor of every cart, as for Cart.
+     */
+    explicit Traffic(const RoadShape& shape, float scale = 1.0f);
+
+    /**
+     * @brief Puts a cart on the road.
+     *
+     * @param distance Distance from the left end of the road, clamped to the road.
+     * @param speed Distance the cart travels per step.
+     * @param movingLeft True if the cart starts out driving left.
+     * @return Index of the new cart.
+     */
+    size_t addCart(double distance, float speed, bool movingLeft = false);
+
+    /**
+     * @brief Removes every cart.
+     */
+    void clear();
+
+    /**
+     * @brief Reserves room for a number of carts.
+     *
+     * @param count Number of carts.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Gets the number of carts.
+     *
+     * @return The cart count.
+     */
+    size_t size() const { return distance_.size(); }
+
+    /**
+     * @brief Moves every cart by its speed, on the calling thread.
+     */
+    void step();
+
+    /**
+     * @brief Moves every cart by its speed, with the work split across the pool's threads.
+     *
+     * @param pool Threads to step the blocks of carts on.
+     */
+    void step(ThreadPool& pool);
+
+    /**
+     * @brief Sets how carts respond to running into each other.
+     *
+     * @param response The response; NONE lets carts pass through each other.
+     */
+    void setCollisionResponse(CollisionResponse response);
+
+    /**
+     * @brief Gets how carts respond to running into each other.
+     *
+     * @return The response.
+     */
+    CollisionResponse getCollisionResponse() const { return response_; }
+
+    /**
+     * @brief Gets the number of touching pairs the last step found and resolved.
+     *
+     * @return The collision count, always 0 without collisions.
+     */
+    size_t getCollisionCount() const { return collisionCount_; }
+
+    /**
+     * @brief Gets the carts sorted by distance from the left end of the road.
+     *
+     * @return Indices of the carts, nearest to the left end first; only kept sorted while collisions are on.
+     */
+    const std::vector<size_t>& getOrder() const { return order_; }
+
+    /**
+     * @brief Records every cart's position and orientation as the state before the next step,
+     *        for draw() to blend from.
+     */
+    void capture();
+
+    /**
+     * @brief Draws every cart that may be visible.
+     *
+     * Between two steps, each cart can be shown at the blend of its captured and current state;
+     * orientations blend the shorter way round, and a turn of more than 90 degrees (a cart turning
+     * around) is shown as a jump rather than a spin.
+     *
+     * @param context The render context to draw into.
+     * @param alpha 0 shows the state at the last capture(), 1 the current one.
+     */
+    void draw(RenderContext& context, float alpha = 1.0f) const;
+
+    /**
+     * @brief Gets the road the carts drive on.
+     *
+     * @return The road's shape.
+     */
+    const RoadShape& getShape() const { return *shape_; }
+
+    /** @brief Gets a cart's distance from the left end of the road. */
+    double getDistance(size_t i) const { return distance_[i]; }
+    /** @brief Gets a cart's direction: 1 when driving right, -1 when driving left. */
+    int getDirection(size_t i) const { return direction_[i] < 0.0f ? -1 : 1; }
+    /** @brief Gets the distance a cart travels per step. */
+    float getSpeed(size_t i) const { return speed_[i]; }
+    /** @brief Gets a cart's X-coordinate. */
+    float getX(size_t i) const { return x_[i]; }
+    /** @brief Gets a cart's Y-coordinate. */
+    float getY(size_t i) const { return y_[i]; }
+    /** @brief Gets a cart's orientation in degrees, as Cart::getOrientation(). */
+    float getOrientation(size_t i) const { return orientation_[i]; }
+    /** @brief Gets the rotation of a cart's wheels in degrees. */
+    float getWheelAngle(size_t i) const { return wheelAngle_[i]; }
+    /** @brief Sets the distance a cart travels per step. */
+    void setSpeed(size_t i, float speed) { speed_[i] = speed; }
+    /** @brief Sets the rotation of a cart's wheels in degrees, within [0, 360). */
+    void setWheelAngle(size_t i, float angle) { wheelAngle_[i] = angle; }
+
+    /**
+     * @brief Number of carts stepped together, and the unit step(ThreadPool&) splits the work in.
+     */
+    static constexpr size_t BLOCK_SIZE = 4096;
+
+private:
+    /**
+     * @brief Moves every cart, block by block on the pool's threads or on the calling thread.
+     *
+     * @param pool Threads to step the blocks of carts on, or nullptr.
+     */
+    void stepBlocks(ThreadPool* pool);
+
+    /**
+     * @brief Moves the carts in [first, last) by their speed and turns their wheels.
+     *
+     * @param first Index of the first cart.
+     * @param last Index past the last cart.
+     */
+    void moveRange(size_t first, size_t last);
+
+    /**
+     * @brief Restores the order of order_ after the carts have moved, with an insertion sort.
+     */
+    void sortByDistance();
+
+    /**
+     * @brief Finds the carts that overlap the next one along the road, and separates them.
+     */
+    void resolveCollisions();
+
+    /**
+     * @brief Derives position and orientation from distance and direction for the carts in [first, last).
+     *
+     * @param first Index of the first cart.
+     * @param last Index past the last cart.
+     */
+    void placeRange(size_t first, size_t last);
+
+    /**
+     * @var shape_
+     * @brief The road the carts drive on.
+     */
+    const RoadShape* shape_;
+
+    /**
+     * @var cartWidth_
+     * @brief Width of the cart body.
+     */
+    float cartWidth_;
+
+    /**
+     * @var cartHeight_
+     * @brief Height of the cart body.
+     */
+    float cartHeight_;
+
+    /**
+     * @var wheelRadius_
+     * @brief Radius of the wheels.
+     */
+    float wheelRadius_;
+
+    /**
+     * @var response_
+     * @brief How carts respond to running into each other.
+     */
+    CollisionResponse response_;
+
+    /**
+     * @var collisionCount_
+     * @brief Number of collisions the last step resolved.
+     */
+    size_t collisionCount_;
+
+    /**
+     * @var order_
+     * @brief Indices of the carts sorted by distance; only kept up to date while collisions are on.
+     */
+    std::vector<size_t> order_;
+
+    /**
+     * @var distance_
+     * @brief Distance of every cart from the left end of the road.
+     */
+    std::vector<double> distance_;
+
+    /**
+     * @var direction_
+     * @brief Direction of every cart: 1 when driving right, -1 when driving left.
+     */
+    std::vector<float> direction_;
+
+    /**
+     * @var speed_
+     * @brief Distance every cart travels per step.
+     */
+    std::vector<float> speed_;
+
+    /**
+     * @var wheelAngle_
+     * @brief Rotation of every cart's wheels, in degrees within [0, 360).
+     */
+    std::vector<float> wheelAngle_;
+
+    /**
+     * @var x_
+     * @brief X-coordinate of every cart.
+     */
+    std::vector<float> x_;
+
+    /**
+     * @var y_
+     * @brief Y-coordinate of every cart.
+     */
+    std::vector<float> y_;
+
+    /**
+     * @var orientation_
+     * @brief Orientation of every cart in degrees.
+     */
+    std::vector<float> orientation_;
+
+    /**
+     * @var previousX_
+     * @brief X-coordinate of every cart at the last capture().
+     */
+    std::vector<float> previousX_;
+
+    /**
+     * @var previousY_
+     * @brief Y-coordinate of every cart at the last capture().
+     */
+    std::vector<float> previousY_;
+
+    /**
+     * @var previousOrientation_
+     * @brief Orientation of every cart at the last capture(), in degrees.
+     */
+    std::vector<float> previousOrientation_;
+
+    /**
+     * @var bodies_
+     * @brief Scratch buffer for the body quads of the carts being drawn.
+     */
+    mutable std::vector<float> bodies_;
+
+    /**
+     * @var noses_
+     * @brief Scratch buffer for the nose triangles of the carts being drawn.
+     */
+    mutable std::vector<float> noses_;
+
+    /**
+     * @var wheels_
+     * @brief Scratch buffer for the rim and spoke segments of the carts being drawn.
+     */
+    mutable std::vector<float> wheels_;
+};
+
+#endif // TRAFFIC_H
@@ -0,0 +1,25 @@
+#include "UnitCircle.h"
+#include <cmath>
+#include <map>
+#include <mutex>
+
+const std::vector<UnitCirclePoint>& UnitCircle::get(int segments) {
+    // std::map never moves its nodes, so references to the tables stay valid as it grows
+    static std::map<int, std::vector<UnitCirclePoint>> tables;
+    static std::mutex tablesMutex;
+
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    auto found = tables.find(segments);
+    if (found != tables.end()) {
+        return found->second;
+    }
+
+    // First request for this segment count: build the table once
+    std::vector<UnitCirclePoint>& table = tables[segments];
+    table.reserve(segments);
+    for (int i = 0; i < segments; i++) {
+        float theta = 2.0f * 3.1415926f * float(i) / float(segments);  // Angle in radians
+        table.push_back({ cosf(theta), sinf(theta) });
+    }
+    return table;
+}
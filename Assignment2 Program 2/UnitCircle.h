@@ -0,0 +1,46 @@
+#ifndef UNITCIRCLE_H
+#define UNITCIRCLE_H
+
+#include <vector>
+
+/**
+ * @struct UnitCirclePoint
+ * @brief A single point on the unit circle.
+ */
+struct UnitCirclePoint {
+    float x; /**< cos(theta) */
+    float y; /**< sin(theta) */
+};
+
+/**
+ * @class UnitCircle
+ * @brief Shared, lazily built tables of points on the unit circle.
+ *
+ * Tessellating an ellipse or a wheel only needs cos/sin of evenly spaced angles, and those
+ * never change for a given segment count. This class computes each table once, the first time
+ * a segment count is requested, and hands out the same table to every caller afterwards so
+ * drawing code only has to scale and offset the points.
+ *
+ * @note Returned references stay valid for the lifetime of the program.
+ *
+ * @author Harrison Grenier
+ */
+class UnitCircle {
+public:
+    /**
+     * @brief Returns the unit-circle table for the given number of segments.
+     *
+     * Point i of the table is (cos(2*pi*i/segments), sin(2*pi*i/segments)).
+     *
+     * @param segments Number of evenly spaced points around the circle (must be positive).
+     * @return The cached table of points, built on first use.
+     */
+    static const std::vector<UnitCirclePoint>& get(int segments);
+
+    /**
+     * @brief Deleted constructor, the class only exposes static lookups.
+     */
+    UnitCircle() = delete;
+};
+
+#endif // UNITCIRCLE_H
@@ -0,0 +1,30 @@
+#ifndef ANIMATABLE_H
+#define ANIMATABLE_H
+
+/**
+ * @class Animatable
+ * @brief Interface for scene objects that change over time.
+ *
+ * Objects that animate implement update() and are registered in an AnimationList when they are
+ * created, so the animation tick visits only them, with a plain virtual call and no type checks.
+ *
+ * @see AnimationList
+ *
+ * @author Harrison Grenier
+ */
+class Animatable {
+public:
+    /**
+     * @brief Default virtual destructor for Animatable.
+     */
+    virtual ~Animatable() = default;
+
+    /**
+     * @brief Advances the object's animation.
+     *
+     * @param dt Elapsed time in seconds.
+     */
+    virtual void update(float dt) = 0;
+};
+
+#endif // ANIMATABLE_H
@@ -0,0 +1,12 @@
+#include "AnimationList.h"
+#include <algorithm>
+
+void AnimationList::remove(Animatable* object) {
+    objects_.erase(std::remove(objects_.begin(), objects_.end(), object), objects_.end());
+}
+
+void AnimationList::update(float dt) {
+    for (Animatable* object : objects_) {
+        object->update(dt);
+    }
+}
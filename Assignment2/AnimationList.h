@@ -0,0 +1,62 @@
+#ifndef ANIMATIONLIST_H
+#define ANIMATIONLIST_H
+
+#include "Animatable.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class AnimationList
+ * @brief The objects that animate, kept apart from the list of everything that is drawn.
+ *
+ * The list holds non-owning pointers; objects must be removed before they are destroyed.
+ * Objects are updated in the order they were added.
+ *
+ * @see Animatable
+ *
+ * @author Harrison Grenier
+ */
+class AnimationList {
+public:
+    /**
+     * @brief Registers an object so update() advances it.
+     *
+     * @param object The object to animate.
+     */
+    void add(Animatable* object) { objects_.push_back(object); }
+
+    /**
+     * @brief Unregisters an object. Does nothing if it isn't registered.
+     *
+     * @param object The object to stop animating.
+     */
+    void remove(Animatable* object);
+
+    /**
+     * @brief Unregisters every object.
+     */
+    void clear() { objects_.clear(); }
+
+    /**
+     * @brief Gets the number of registered objects.
+     *
+     * @return The object count.
+     */
+    size_t size() const { return objects_.size(); }
+
+    /**
+     * @brief Advances every registered object.
+     *
+     * @param dt Elapsed time in seconds.
+     */
+    void update(float dt);
+
+private:
+    /**
+     * @var objects_
+     * @brief The registered objects, in registration order.
+     */
+    std::vector<Animatable*> objects_;
+};
+
+#endif // ANIMATIONLIST_H
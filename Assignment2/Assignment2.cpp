@@ -10,10 +10,26 @@
 #include <cstdio>
 #include <vector>
 #include <memory>
+#include <chrono>
+#include <iostream>
+#include <algorithm>
 //
 #include "glPlatform.h"
-#include "portrait.h"
+#include "Portrait.h"
 #include "PortraitWheel.h"
+#include "SceneArena.h"
+#include "AnimationList.h"
+#include "FixedTimestep.h"
+#include "TransformInterpolator.h"
+#include "SpatialGrid.h"
+#include "InstancedPortraitRenderer.h"
+#include "GLRenderContext.h"
+#include "SoftwareRasterizer.h"
+#include "BatchRenderContext.h"
+#include "SceneFile.h"
+#include "Logger.h"
+#include "InputRecorder.h"
+#include "BenchmarkStats.h"
 
 using namespace std;
 
@@ -21,9 +37,28 @@ using namespace std;
 void myDisplay(void);
 void myResize(int w, int h);
 void myInit(void);
-void myTimerFunc(int value);
+void myIdleFunc(void);
+void updateIdleFunc(void);
 void handleKeyboard(unsigned char c, int x, int y);
 void handleMouse(int button, int state, int x, int y);
+void handleMotion(int x, int y);
+void onKeyboard(unsigned char key, int x, int y);
+void onMouse(int button, int state, int x, int y);
+void onMotion(int x, int y);
+void onResize(int w, int h);
+void replayResize(int w, int h);
+void runTicks(int ticks);
+void finishReplay(void);
+void windowToWorld(int x, int y, float& worldX, float& worldY);
+void deleteSelected(void);
+int renderOffline(int frames, const char* outputPattern);
+void addWheel(PortraitWheel* wheel);
+void addWheels(const vector<WheelSpec>& specs);
+void fillWithWheels(int columns);
+void addDefaultWheels(void);
+void clearScene(void);
+bool saveScene(const string& path);
+bool loadScene(const string& path);
 
 
 // inital window perams
@@ -38,8 +73,44 @@ Y_MAX = 10.0f, Y_MIN = -10.0f;
 int winWidth = 600,
 winHeight = 600;
 
-// vector to store all the graphic objects
-std::vector<std::shared_ptr<GraphicObject2D>> drawableObjects;
+// arena that owns every wheel and portrait of the scene, freed all at once on exit
+SceneArena sceneArena;
+
+// vector to store all the graphic objects (non-owning handles into sceneArena)
+std::vector<GraphicObject2D*> drawableObjects;
+
+// the subset of drawableObjects that animates, advanced by the timer
+AnimationList animatedObjects;
+
+// time covered by one animation tick (the simulation runs at 62.5 ticks per second)
+const float TICK_SECONDS = 0.016f;
+
+// turns measured real time into whole ticks, independently of the frame rate
+FixedTimestep simulationClock(TICK_SECONDS);
+
+// shows the wheels between the last two ticks when a frame falls between them
+TransformInterpolator interpolator;
+
+// grid over the drawable objects' bounds, so picking doesn't scan every wheel
+SpatialGrid sceneIndex;
+
+// wheel picked with the right mouse button, and where on it the drag started
+GraphicObject2D* selectedObject = nullptr;
+bool isDragging = false;
+float dragOffsetX = 0.0f, dragOffsetY = 0.0f;
+
+// scene file written by 'S' and read by 'L', set with --scene (which also loads it at startup)
+string scenePath = "scene.a2s";
+bool sceneRequested = false;
+
+// records the session's input with --record, or plays a recorded session back with --replay
+InputRecorder inputRecorder;
+
+// handlers recorded events are played back through: the same ones GLUT calls, minus the recording
+const InputHandlers replayHandlers = { handleKeyboard, handleMouse, handleMotion, replayResize, runTicks };
+
+// frame timings of a replay, printed when it ends
+BenchmarkStats replayStats;
 
 
 
@@ -49,8 +120,29 @@ WheelSize currentWheelSize = WheelSize::MEDIUM;         // Default size
 int currentNumPortraits = 5;                           // Default number of portraits
 bool isAnimationOn = false;  // Global variable to track the animation state
 
+// The ways the scene can be sent to OpenGL
+enum class RenderPath {
+	IMMEDIATE, // every object draws itself with immediate-mode calls
+	BATCHED,   // all objects are merged into one vertex stream per frame
+	INSTANCED  // portraits are drawn from a retained mesh with one instanced call
+};
+RenderPath renderPath = RenderPath::IMMEDIATE;
+
+// Retained-mode renderer, set up once the GL context exists
+InstancedPortraitRenderer instancedRenderer;
+
+// Immediate-mode OpenGL backend the scene is drawn into
+GLRenderContext glContext;
+
+// Frame-wide batcher used by the BATCHED path
+BatchRenderContext batchContext;
+
 
 void myDisplay(void) {
+	if (inputRecorder.isReplaying()) {
+		replayStats.beginFrame();
+	}
+
 	// Clear the buffer(s) we draw into
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
@@ -58,15 +150,53 @@ void myDisplay(void) {
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
 
-	// Iterate over all drawable objects and draw them
-	for (const auto& obj : drawableObjects) {
-		if (obj) {
-			obj->draw();  // This will call the correct draw method based on the object's type
+	// Draw the scene as it is at this moment, between the last two simulation ticks
+	// (a replay always shows whole ticks, so its frames don't depend on the machine's speed)
+	bool blend = isAnimationOn && !inputRecorder.isReplaying();
+	interpolator.apply(blend ? simulationClock.getAlpha() : 1.0f);
+
+	if (renderPath == RenderPath::INSTANCED && instancedRenderer.isReady()) {
+		// Upload all portrait placements and draw them with a single instanced call
+		instancedRenderer.draw(drawableObjects);
+	}
+	else if (renderPath == RenderPath::BATCHED) {
+		// Collect every object's triangles into one stream and submit it at once
+		batchContext.beginFrame();
+		for (const auto& obj : drawableObjects) {
+			if (obj && batchContext.isVisible(obj->getBounds())) {
+				obj->draw(batchContext);
+			}
 		}
+		batchContext.flush();
+	}
+	else {
+		// Iterate over all drawable objects and draw them
+		for (const auto& obj : drawableObjects) {
+			if (obj && glContext.isVisible(obj->getBounds())) {
+				obj->draw(glContext);  // This will call the correct draw method based on the object's type
+			}
+		}
+	}
+	interpolator.restore();
+
+	// Outline the selected wheel
+	if (selectedObject) {
+		BoundingBox2D box = selectedObject->getBounds();
+		glContext.setColor(1.0f, 1.0f, 0.0f);
+		glContext.begin(PrimitiveType::LINE_LOOP);
+		glContext.vertex(box.minX, box.minY);
+		glContext.vertex(box.maxX, box.minY);
+		glContext.vertex(box.maxX, box.maxY);
+		glContext.vertex(box.minX, box.maxY);
+		glContext.end();
 	}
 
 	// Switch the drawing on the back buffer to the front screen
 	glutSwapBuffers();
+
+	if (inputRecorder.isReplaying()) {
+		replayStats.endFrame();
+	}
 }
 
 
@@ -82,12 +212,24 @@ void myResize(int w, int h) {
 	float aspectRatio = (float)w / (float)h;
 
 	// Adjust the projection based on the aspect ratio
+	BoundingBox2D view;
 	if (aspectRatio > 1.0f) { // Wider than tall
-		gluOrtho2D(X_MIN * aspectRatio, X_MAX * aspectRatio, Y_MIN, Y_MAX);
+		view = { X_MIN * aspectRatio, Y_MIN, X_MAX * aspectRatio, Y_MAX };
 	}
 	else { // Taller than wide
-		gluOrtho2D(X_MIN, X_MAX, Y_MIN / aspectRatio, Y_MAX / aspectRatio);
+		view = { X_MIN, Y_MIN / aspectRatio, X_MAX, Y_MAX / aspectRatio };
 	}
+	gluOrtho2D(view.minX, view.maxX, view.minY, view.maxY);
+
+	// Objects outside the projected region are skipped before any geometry is emitted
+	glContext.setViewBounds(view);
+	batchContext.setViewBounds(view);
+	instancedRenderer.setViewBounds(view);
+
+	// Both branches keep the full 20-unit range along the window's shorter side
+	float pixelsPerUnit = min(w, h) / (X_MAX - X_MIN);
+	glContext.setPixelsPerUnit(pixelsPerUnit);
+	batchContext.setPixelsPerUnit(pixelsPerUnit);
 
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity(); // Reset the model view matrix after changing projection
@@ -96,26 +238,89 @@ void myResize(int w, int h) {
 	glutPostRedisplay();
 }
 
-void myTimerFunc(int value) {
-	if (isAnimationOn) {
-		// Rotate each PortraitWheel object by 1 degree
-		for (const auto& obj : drawableObjects) {
-			// Check if the object is a PortraitWheel and rotate it
-			std::shared_ptr<PortraitWheel> wheel = std::dynamic_pointer_cast<PortraitWheel>(obj);
-			if (wheel) {
-				float currentOrientation = wheel->getOrientation();
-				wheel->setOrientation(currentOrientation + 1.0f);  // Rotate by 1 degree per frame
-			}
+// Called whenever GLUT has no events to handle: catch the simulation up with real time, then redraw.
+// Slow frames run several ticks, fast frames none, so the wheels always turn at the same speed
+// During a replay the recorded events, tick counts included, take the place of input and real time
+void myIdleFunc(void) {
+	if (inputRecorder.isReplaying()) {
+		inputRecorder.replay(replayHandlers);
+		if (!inputRecorder.isReplaying()) {
+			finishReplay();
 		}
 	}
-
-	// Re-prime the timer to fire again in 16 milliseconds (roughly 60 frames per second)
-	glutTimerFunc(16, myTimerFunc, 0);
+	else if (isAnimationOn) {
+		int ticks = simulationClock.advance();
+		inputRecorder.recordTicks(ticks);
+		runTicks(ticks);
+	}
 
 	// Request a refresh of the display to see the updated animation
 	glutPostRedisplay();
 }
 
+// Runs the idle loop only while something moves: a paused window would otherwise redraw as fast as
+// it can, so it only redraws when input or a resize asks it to
+void updateIdleFunc(void) {
+	glutIdleFunc(isAnimationOn || inputRecorder.isReplaying() ? myIdleFunc : nullptr);
+}
+
+
+// Advances the simulation by a number of ticks
+void runTicks(int ticks) {
+	for (int i = 0; i < ticks; i++) {
+		// Advance only the objects that animate (each wheel turns by 1 degree per tick)
+		interpolator.capture();
+		animatedObjects.update(TICK_SECONDS);
+	}
+}
+
+
+// GLUT input callbacks: record the event, then handle it. Live input is ignored during a replay,
+// except Escape to quit and resizes, which the window has to follow anyway
+void onKeyboard(unsigned char key, int x, int y) {
+	if (inputRecorder.isReplaying() && key != 27) {
+		return;
+	}
+	inputRecorder.recordKeyboard(key, x, y);
+	handleKeyboard(key, x, y);
+}
+
+void onMouse(int button, int state, int x, int y) {
+	if (inputRecorder.isReplaying()) {
+		return;
+	}
+	inputRecorder.recordMouse(button, state, x, y);
+	handleMouse(button, state, x, y);
+}
+
+void onMotion(int x, int y) {
+	if (inputRecorder.isReplaying()) {
+		return;
+	}
+	inputRecorder.recordMotion(x, y);
+	handleMotion(x, y);
+}
+
+void onResize(int w, int h) {
+	inputRecorder.recordResize(w, h);
+	myResize(w, h);
+}
+
+
+// Gives the window its recorded size; the projection is set right away so the events that follow
+// map to the same world positions as when they were recorded
+void replayResize(int w, int h) {
+	glutReshapeWindow(w, h);
+	myResize(w, h);
+}
+
+
+// Prints the frame timings of the replay that just ended and quits
+void finishReplay(void) {
+	replayStats.print(cout, drawableObjects.size(), "objects");
+	exit(0);
+}
+
 
 // check for user keyboard inputs
 void handleKeyboard(unsigned char key, int x, int y) {
@@ -143,6 +348,27 @@ void handleKeyboard(unsigned char key, int x, int y) {
 		break;
 	case ' ': // Toggle animation mode on/off with space key
 		isAnimationOn = !isAnimationOn;
+		interpolator.capture();   // show the current state until the next tick
+		simulationClock.reset();  // time spent paused doesn't count
+		updateIdleFunc();
+		break;
+	case 'i': // Toggle the instanced (VBO) rendering path
+		renderPath = (renderPath != RenderPath::INSTANCED && instancedRenderer.isReady()) ? RenderPath::INSTANCED : RenderPath::IMMEDIATE;
+		break;
+	case 'b': // Toggle the frame-wide batched rendering path
+		renderPath = (renderPath != RenderPath::BATCHED) ? RenderPath::BATCHED : RenderPath::IMMEDIATE;
+		break;
+	case 'g': // Fill the view with a 100 x 100 grid of small wheels
+		fillWithWheels(100);
+		break;
+	case 'S': // Save the scene to the scene file
+		saveScene(scenePath);
+		break;
+	case 'L': // Replace the scene with the one in the scene file
+		loadScene(scenePath);
+		break;
+	case 'x': // Delete the selected wheel
+		deleteSelected();
 		break;
 	case 27: // Escape key to exit the program
 		exit(0);
@@ -157,30 +383,288 @@ void handleKeyboard(unsigned char key, int x, int y) {
 void handleMouse(int button, int state, int x, int y) {
 	if (button == GLUT_LEFT_BUTTON && state == GLUT_DOWN) {
 		// Convert the mouse click coordinates to the OpenGL coordinate system
-		float mouseX = (x / (float)winWidth) * (X_MAX - X_MIN) + X_MIN;
-		float mouseY = ((winHeight - y) / (float)winHeight) * (Y_MAX - Y_MIN) + Y_MIN;
+		float mouseX, mouseY;
+		windowToWorld(x, y, mouseX, mouseY);
 
-		// Create a new PortraitWheel object at the mouse location using current global mode settings
-		std::shared_ptr<GraphicObject2D> newWheel = std::make_shared<PortraitWheel>(
-			currentWheelType, currentWheelSize, currentNumPortraits, mouseX, mouseY
+		// Create a new PortraitWheel object at the mouse location using current global mode settings,
+		// with the wheel and all its portraits placed together in the scene arena
+		PortraitWheel* newWheel = sceneArena.create<PortraitWheel>(
+			currentWheelType, currentWheelSize, currentNumPortraits, mouseX, mouseY, &sceneArena
 		);
 
-		// Add the new object to the list of drawable objects
-		drawableObjects.push_back(newWheel);
+		// Add the new object to the lists of drawable and animated objects
+		addWheel(newWheel);
 
 		// Request a redisplay to update the screen
 		glutPostRedisplay();
 	}
+	else if (button == GLUT_RIGHT_BUTTON && state == GLUT_DOWN) {
+		float mouseX, mouseY;
+		windowToWorld(x, y, mouseX, mouseY);
+
+		// Select the wheel owning the topmost portrait under the cursor, or clear the selection
+		PortraitHit hit = sceneIndex.pickPortrait(mouseX, mouseY);
+		selectedObject = hit.object;
+		isDragging = selectedObject != nullptr;
+		if (selectedObject) {
+			dragOffsetX = selectedObject->getPositionX() - mouseX;
+			dragOffsetY = selectedObject->getPositionY() - mouseY;
+		}
+		glutPostRedisplay();
+	}
+	else if (button == GLUT_RIGHT_BUTTON && state == GLUT_UP) {
+		isDragging = false;
+	}
+}
+
+
+// Moves the selected wheel with the mouse while the right button is held
+void handleMotion(int x, int y) {
+	if (!isDragging || !selectedObject) {
+		return;
+	}
+
+	float mouseX, mouseY;
+	windowToWorld(x, y, mouseX, mouseY);
+	selectedObject->setPosition(mouseX + dragOffsetX, mouseY + dragOffsetY);
+	sceneIndex.update(selectedObject);
+
+	glutPostRedisplay();
+}
+
+
+// Converts window pixel coordinates to the world coordinates shown at that pixel
+void windowToWorld(int x, int y, float& worldX, float& worldY) {
+	BoundingBox2D view = glContext.getViewBounds();
+	if (view.isInfinite()) {
+		view = { X_MIN, Y_MIN, X_MAX, Y_MAX };
+	}
+	worldX = (x / (float)winWidth) * (view.maxX - view.minX) + view.minX;
+	worldY = ((winHeight - y) / (float)winHeight) * (view.maxY - view.minY) + view.minY;
+}
+
+
+// Registers a wheel for drawing, animation and picking
+void addWheel(PortraitWheel* wheel) {
+	drawableObjects.push_back(wheel);
+	animatedObjects.add(wheel);
+	interpolator.track(wheel);
+	sceneIndex.insert(wheel);
+}
+
+
+// Builds many wheels in parallel into the scene arena and registers them in order
+void addWheels(const vector<WheelSpec>& specs) {
+	static ThreadPool builders;  // created on first use, one thread per core
+	for (PortraitWheel* wheel : PortraitWheel::createMany(specs, sceneArena, builders)) {
+		addWheel(wheel);
+	}
+}
+
+
+// Covers the original 20 x 20 view with columns x columns small wheels of the current type and portrait count
+void fillWithWheels(int columns) {
+	float cellWidth = (X_MAX - X_MIN) / columns, cellHeight = (Y_MAX - Y_MIN) / columns;
+	vector<WheelSpec> specs;
+	specs.reserve(columns * columns);
+	for (int row = 0; row < columns; row++) {
+		for (int column = 0; column < columns; column++) {
+			specs.push_back({ currentWheelType, WheelSize::SMALL, currentNumPortraits,
+				X_MIN + (column + 0.5f) * cellWidth, Y_MIN + (row + 0.5f) * cellHeight });
+		}
+	}
+	addWheels(specs);
+}
+
+
+// Removes every wheel and frees the arena they were built in
+void clearScene(void) {
+	interpolator.clear();  // every tracked object is in the scene, so none stays tracked
+	drawableObjects.clear();
+	animatedObjects.clear();
+	sceneIndex.clear();
+	selectedObject = nullptr;
+	isDragging = false;
+	sceneArena.release();
+}
+
+
+// Writes every wheel's type, size, portrait count, position and orientation
+bool saveScene(const string& path) {
+	vector<WheelRecord> wheels;
+	wheels.reserve(drawableObjects.size());
+	for (GraphicObject2D* obj : drawableObjects) {
+		if (auto* wheel = dynamic_cast<PortraitWheel*>(obj)) {
+			wheels.push_back(wheel->toRecord());
+		}
+	}
+
+	if (!SceneFile::write(path, { SceneFile::section(SceneSectionType::WHEELS, wheels) })) {
+		LOG_ERROR("could not write %s", path.c_str());
+		return false;
+	}
+	LOG_INFO("saved %zu wheels to %s", wheels.size(), path.c_str());
+	return true;
+}
+
+
+// Maps a scene file and rebuilds its wheels in place of the current scene
+bool loadScene(const string& path) {
+	SceneFile file;
+	if (!file.open(path)) {
+		LOG_WARNING("%s", file.getError().c_str());
+		return false;
+	}
+
+	size_t count;
+	const WheelRecord* records = file.getSection<WheelRecord>(SceneSectionType::WHEELS, count);
+	vector<WheelSpec> specs;
+	specs.reserve(count);
+	for (size_t i = 0; i < count; i++) {
+		specs.push_back(PortraitWheel::specFromRecord(records[i]));
+	}
+
+	clearScene();
+	addWheels(specs);
+	interpolator.capture();  // nothing to blend from yet
+	LOG_INFO("loaded %zu wheels from %s", count, path.c_str());
+	return true;
+}
+
+
+// Takes the selected wheel out of the scene; its memory stays in the arena until the arena is released
+void deleteSelected(void) {
+	if (!selectedObject) {
+		return;
+	}
+
+	drawableObjects.erase(remove(drawableObjects.begin(), drawableObjects.end(), selectedObject), drawableObjects.end());
+	if (auto* wheel = dynamic_cast<PortraitWheel*>(selectedObject)) {
+		animatedObjects.remove(wheel);
+	}
+	interpolator.untrack(selectedObject);
+	sceneIndex.remove(selectedObject);
+
+	selectedObject = nullptr;
+	isDragging = false;
 }
 
 
 void myInit(void)
 {
+	// Needs the GL context created by glutCreateWindow
+	instancedRenderer.initialize();
+
+	// Start from the scene file given on the command line
+	if (sceneRequested) {
+		loadScene(scenePath);
+	}
 
 	myDisplay();
 }
 
+// One wheel of every type and size, with 3 to 9 portraits, spread over the view
+void addDefaultWheels(void) {
+	vector<WheelSpec> specs;
+	int wheelIndex = 0;
+	for (float y = Y_MIN + 2.5f; y < Y_MAX; y += 5.0f) {
+		for (float x = X_MIN + 2.5f; x < X_MAX; x += 5.0f, wheelIndex++) {
+			WheelType type = (wheelIndex % 2 == 0) ? WheelType::HEADS_ON_WHEEL : WheelType::HEADS_ON_STICKS;
+			WheelSize size = static_cast<WheelSize>(wheelIndex % 3);
+			specs.push_back({ type, size, 3 + wheelIndex % 7, x, y });
+		}
+	}
+	addWheels(specs);
+}
+
+// Render an animated grid of wheels with the software rasterizer, without a window or GPU
+int renderOffline(int frames, const char* outputPattern) {
+	// The wheels from the scene file if one was given, otherwise a grid of every kind
+	if (!sceneRequested || !loadScene(scenePath)) {
+		addDefaultWheels();
+	}
+
+	// The pattern is checked before any frame is drawn rather than handed to printf
+	string path;
+	if (outputPattern != nullptr && !SoftwareRasterizer::formatFramePath(outputPattern, 0, path)) {
+		cerr << "the output pattern needs exactly one %d, e.g. frame_%04d.png: " << outputPattern << endl;
+		return 1;
+	}
+
+	SoftwareRasterizer rasterizer(winWidth, winHeight, X_MIN, X_MAX, Y_MIN, Y_MAX);
+	auto start = chrono::steady_clock::now();
+	for (int frame = 0; frame < frames; frame++) {
+		rasterizer.beginFrame();
+		for (const auto& obj : drawableObjects) {
+			if (rasterizer.isVisible(obj->getBounds())) {
+				obj->draw(rasterizer);
+			}
+		}
+		rasterizer.endFrame();
+		animatedObjects.update(TICK_SECONDS);  // one simulation tick per frame
+
+		if (outputPattern != nullptr) {
+			SoftwareRasterizer::formatFramePath(outputPattern, frame, path);
+			if (!rasterizer.writeImage(path)) {
+				cerr << "could not write " << path << endl;
+				return 1;
+			}
+		}
+	}
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	cout << frames << " frames in " << seconds << " s";
+	if (frames > 0 && seconds > 0.0) {
+		cout << " (" << frames / seconds << " fps)";
+	}
+	cout << " on " << rasterizer.getThreadCount() << " threads" << endl;
+	return 0;
+}
+
 int main(int argc, char** argv) {
+	// Leading options: Assignment2 [--scene <file>] [--record <log> | --replay <log> [--fast]] [...]
+	string recordPath, replayPath;
+	bool replayFast = false;
+	while (argc >= 2) {
+		string option = argv[1];
+		int used;
+		if (option == "--fast") {
+			replayFast = true;
+			used = 1;
+		}
+		else if (argc >= 3 && (option == "--scene" || option == "--record" || option == "--replay")) {
+			if (option == "--scene") {
+				scenePath = argv[2];
+				sceneRequested = true;
+			}
+			else {
+				(option == "--record" ? recordPath : replayPath) = argv[2];
+			}
+			used = 2;
+		}
+		else {
+			break;
+		}
+		argv[used] = argv[0];
+		argc -= used;
+		argv += used;
+	}
+
+	// Headless mode: Assignment2 [--scene <file>] --offline <frames> [output pattern, e.g. frame_%04d.png]
+	if (argc >= 3 && string(argv[1]) == "--offline") {
+		return renderOffline(atoi(argv[2]), argc >= 4 ? argv[3] : nullptr);
+	}
+
+	// The log has to be valid before a window is opened for it
+	if (!replayPath.empty() && !inputRecorder.loadReplay(replayPath, replayFast)) {
+		cerr << inputRecorder.getError() << endl;
+		return 1;
+	}
+	if (!recordPath.empty() && !inputRecorder.startRecording(recordPath)) {
+		cerr << "could not create " << recordPath << endl;
+		return 1;
+	}
+
 	// Initialize glut and create a new window
 	glutInit(&argc, argv);
 	glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGBA);
@@ -188,12 +672,13 @@ int main(int argc, char** argv) {
 	glutInitWindowPosition(INIT_WIN_X, INIT_WIN_Y);
 	glutCreateWindow("Harry Grenier Assignment 2");
 
-	// Set up the callbacks for display, resize, timer, keyboard, and mouse events
+	// Set up the callbacks for display, resize, idle, keyboard, mouse, and drag events
 	glutDisplayFunc(myDisplay);
-	glutReshapeFunc(myResize);
-	glutTimerFunc(10, myTimerFunc, 0);
-	glutKeyboardFunc(handleKeyboard);
-	glutMouseFunc(handleMouse);
+	glutReshapeFunc(onResize);
+	updateIdleFunc();  // Drive the animation loop from real elapsed time, or from a replayed log
+	glutKeyboardFunc(onKeyboard);
+	glutMouseFunc(onMouse);
+	glutMotionFunc(onMotion);
 
 
 	myInit();
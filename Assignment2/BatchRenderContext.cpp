@@ -0,0 +1,51 @@
+#include "BatchRenderContext.h"
+#include "glPlatform.h"
+
+void BatchRenderContext::beginFrame() {
+    // clear() keeps the capacity, so a steady scene stops allocating after the first frame
+    vertices_.clear();
+    runs_.clear();
+    resetMatrix();
+}
+
+void BatchRenderContext::emitTriangle(const GeometryVertex& a, const GeometryVertex& b, const GeometryVertex& c,
+                                      const GeometryColor& color) {
+    vertices_.push_back({ a.x, a.y, color.r, color.g, color.b });
+    vertices_.push_back({ b.x, b.y, color.r, color.g, color.b });
+    vertices_.push_back({ c.x, c.y, color.r, color.g, color.b });
+    extendRun(false, 3);
+}
+
+void BatchRenderContext::emitLine(const GeometryVertex& a, const GeometryVertex& b, const GeometryColor& color) {
+    vertices_.push_back({ a.x, a.y, color.r, color.g, color.b });
+    vertices_.push_back({ b.x, b.y, color.r, color.g, color.b });
+    extendRun(true, 2);
+}
+
+void BatchRenderContext::extendRun(bool lines, size_t count) {
+    if (!runs_.empty() && runs_.back().lines == lines) {
+        runs_.back().count += count;
+    }
+    else {
+        runs_.push_back({ lines, vertices_.size() - count, count });
+    }
+}
+
+void BatchRenderContext::flush() {
+    if (vertices_.empty()) {
+        return;
+    }
+
+    // Bind the whole stream once, colors travel with the vertices
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(BatchVertex), &vertices_[0].x);
+    glColorPointer(3, GL_FLOAT, sizeof(BatchVertex), &vertices_[0].r);
+
+    for (const Run& run : runs_) {
+        glDrawArrays(run.lines ? GL_LINES : GL_TRIANGLES, static_cast<GLint>(run.first), static_cast<GLsizei>(run.count));
+    }
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
@@ -0,0 +1,104 @@
+#ifndef BATCHRENDERCONTEXT_H
+#define BATCHRENDERCONTEXT_H
+
+#include "GeometryRenderContext.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @struct BatchVertex
+ * @brief A world-space vertex with its own color, laid out for glVertexPointer/glColorPointer.
+ */
+struct BatchVertex {
+    float x; /**< World X-coordinate */
+    float y; /**< World Y-coordinate */
+    float r; /**< Red color component */
+    float g; /**< Green color component */
+    float b; /**< Blue color component */
+};
+
+/**
+ * @class BatchRenderContext
+ * @brief Frame-wide geometry batcher: the whole scene goes to OpenGL in a handful of draw calls.
+ *
+ * Every object draws into this context as usual. The model transformation is applied on the CPU
+ * and each triangle or line segment is appended, with its color stored per vertex, to one
+ * contiguous vertex stream, so color changes no longer cost a GL state change. flush() then binds
+ * the stream once and issues one glDrawArrays per run of same-kind primitives.
+ *
+ * @note Geometry is not reordered: the scene relies on painter's order, so a new draw call only
+ *       starts where the stream switches between triangles and lines. A scene of portrait wheels
+ *       is all triangles and is drawn with a single call however many wheels it holds.
+ *
+ * @see GeometryRenderContext
+ *
+ * @author Harrison Grenier
+ */
+class BatchRenderContext : public GeometryRenderContext {
+public:
+    /**
+     * @brief Starts a new frame: empties the vertex stream and resets the model matrix.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Submits the frame's vertex stream to OpenGL.
+     *
+     * The modelview matrix must be the identity, since vertices are already in world space.
+     */
+    void flush();
+
+    /**
+     * @brief Gets the number of vertices collected in the current frame.
+     *
+     * @return The vertex count.
+     */
+    size_t getVertexCount() const { return vertices_.size(); }
+
+    /**
+     * @brief Gets the number of draw calls the current frame needs.
+     *
+     * @return The draw call count.
+     */
+    size_t getDrawCallCount() const { return runs_.size(); }
+
+protected:
+    /** @brief Appends the triangle to the vertex stream. */
+    void emitTriangle(const GeometryVertex& a, const GeometryVertex& b, const GeometryVertex& c,
+                      const GeometryColor& color) override;
+    /** @brief Appends the segment to the vertex stream. */
+    void emitLine(const GeometryVertex& a, const GeometryVertex& b, const GeometryColor& color) override;
+
+private:
+    /**
+     * @struct Run
+     * @brief A range of the vertex stream drawn with a single call.
+     */
+    struct Run {
+        bool lines;   /**< True for GL_LINES, false for GL_TRIANGLES */
+        size_t first; /**< Index of the first vertex */
+        size_t count; /**< Number of vertices */
+    };
+
+    /**
+     * @brief Extends the last run if it has the same kind, otherwise starts a new one.
+     *
+     * @param lines Kind of primitive being appended.
+     * @param count Number of vertices being appended.
+     */
+    void extendRun(bool lines, size_t count);
+
+    /**
+     * @var vertices_
+     * @brief The frame's vertex stream.
+     */
+    std::vector<BatchVertex> vertices_;
+
+    /**
+     * @var runs_
+     * @brief Ranges of the stream, one draw call each.
+     */
+    std::vector<Run> runs_;
+};
+
+#endif // BATCHRENDERCONTEXT_H
@@ -0,0 +1,262 @@
+// Headless stress benchmark for the portrait wheels: builds a large scene programmatically,
+// animates it for a fixed number of frames without a window and reports frame-time statistics.
+//
+// usage: bench_wheels [--wheels N] [--frames F] [--warmup W] [--threads T] [--size WxH]
+//                     [--target raster|null|record|none] [--mode objects|pool] [--scene FILE] [--save FILE]
+//                     [--output PATTERN]
+
+#include "PortraitWheel.h"
+#include "SoftwareRasterizer.h"
+#include "NullRenderContext.h"
+#include "RecordingRenderContext.h"
+#include "BenchmarkStats.h"
+#include "SceneArena.h"
+#include "PortraitPool.h"
+#include "AnimationList.h"
+#include "ThreadPool.h"
+#include "SceneFile.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Same world rectangle as the interactive program
+const float X_MAX = 10.0f, X_MIN = -10.0f,
+Y_MAX = 10.0f, Y_MIN = -10.0f;
+
+static void printUsage() {
+	cerr << "usage: bench_wheels [--wheels N] [--frames F] [--warmup W] [--threads T] [--size WxH] "
+		"[--target raster|null|record|none] [--mode objects|pool] [--scene FILE] [--save FILE] [--output PATTERN]\n"
+		"  --wheels N   wheels of every type and size (default 20)\n"
+		"  --frames F   measured frames (default 300)\n"
+		"  --warmup W   unmeasured frames run first (default 10)\n"
+		"  --threads T  scene building and rasterizer threads, 0 = one per core (default 0)\n"
+		"  --size WxH   image size in pixels (default 600x600)\n"
+		"  --target     raster draws into the software rasterizer, null only walks the scene,\n"
+		"               record captures each frame's draw calls and times replaying them into the\n"
+		"               null and raster targets separately, none only animates it\n"
+		"  --mode       objects animates the wheel objects, pool the structure-of-arrays PortraitPool\n"
+		"  --scene FILE load the wheels from a scene file instead of generating them\n"
+		"  --save FILE  write the scene to a scene file before running\n"
+		"  --output     write every measured frame of the raster or record target to an image file,\n"
+		"               named by a pattern with one %d, e.g. frame_%04d.png or frame_%04d.ppm; not timed\n";
+}
+
+int main(int argc, char** argv) {
+	int wheelsPerKind = 20, frames = 300, warmup = 10, width = 600, height = 600;
+	unsigned int threads = 0;
+	string target = "raster", mode = "objects", scenePath, savePath, outputPattern;
+
+	for (int i = 1; i < argc; i++) {
+		string arg = argv[i];
+		bool hasValue = i + 1 < argc;
+		if (arg == "--wheels" && hasValue) wheelsPerKind = atoi(argv[++i]);
+		else if (arg == "--frames" && hasValue) frames = atoi(argv[++i]);
+		else if (arg == "--warmup" && hasValue) warmup = atoi(argv[++i]);
+		else if (arg == "--threads" && hasValue) threads = static_cast<unsigned int>(atoi(argv[++i]));
+		else if (arg == "--size" && hasValue && sscanf(argv[++i], "%dx%d", &width, &height) == 2) {}
+		else if (arg == "--target" && hasValue) target = argv[++i];
+		else if (arg == "--mode" && hasValue) mode = argv[++i];
+		else if (arg == "--scene" && hasValue) scenePath = argv[++i];
+		else if (arg == "--save" && hasValue) savePath = argv[++i];
+		else if (arg == "--output" && hasValue) outputPattern = argv[++i];
+		else {
+			printUsage();
+			return 1;
+		}
+	}
+	string outputPath;
+	if (wheelsPerKind < 1 || frames < 1 || warmup < 0 || width < 1 || height < 1 ||
+		(target != "raster" && target != "null" && target != "record" && target != "none") || (mode != "objects" && mode != "pool") ||
+		(!outputPattern.empty() && ((target != "raster" && target != "record") ||
+		!SoftwareRasterizer::formatFramePath(outputPattern, 0, outputPath)))) {
+		printUsage();
+		return 1;
+	}
+
+	// One block of wheels per type and size, every wheel with 3 to 9 portraits, laid out on a grid
+	// covering the view so both culling and overdraw behave like a crowded window
+	const WheelType types[] = { WheelType::HEADS_ON_WHEEL, WheelType::HEADS_ON_STICKS };
+	const WheelSize sizes[] = { WheelSize::SMALL, WheelSize::MEDIUM, WheelSize::LARGE };
+	vector<WheelSpec> specs;
+	double openMs = 0.0;
+	if (scenePath.empty()) {
+		int generated = wheelsPerKind * 6;
+		int columns = static_cast<int>(ceil(sqrt(static_cast<double>(generated))));
+		float cellWidth = (X_MAX - X_MIN) / columns, cellHeight = (Y_MAX - Y_MIN) / columns;
+		specs.reserve(generated);
+		for (int i = 0; i < generated; i++) {
+			int kind = i % 6;
+			float x = X_MIN + (i % columns + 0.5f) * cellWidth;
+			float y = Y_MIN + (i / columns + 0.5f) * cellHeight;
+			specs.push_back({ types[kind % 2], sizes[kind / 2], 3 + i % 7, x, y });
+		}
+	}
+	else {
+		// The records are read straight from the mapping
+		auto openStart = chrono::steady_clock::now();
+		SceneFile file;
+		if (!file.open(scenePath)) {
+			cerr << file.getError() << endl;
+			return 1;
+		}
+		size_t count;
+		const WheelRecord* records = file.getSection<WheelRecord>(SceneSectionType::WHEELS, count);
+		openMs = chrono::duration<double, milli>(chrono::steady_clock::now() - openStart).count();
+		specs.reserve(count);
+		for (size_t i = 0; i < count; i++) {
+			specs.push_back(PortraitWheel::specFromRecord(records[i]));
+		}
+	}
+	size_t wheelCount = specs.size(), portraitCount = 0;
+	for (const WheelSpec& spec : specs) {
+		portraitCount += spec.numPortraits;
+	}
+
+	// Build the scene in parallel, timed separately from the frames
+	SceneArena arena;
+	ThreadPool builders(threads);
+	auto buildStart = chrono::steady_clock::now();
+	vector<PortraitWheel*> built = PortraitWheel::createMany(specs, arena, builders);
+	double buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - buildStart).count();
+
+	if (!savePath.empty()) {
+		vector<WheelRecord> records;
+		records.reserve(built.size());
+		for (PortraitWheel* wheel : built) {
+			records.push_back(wheel->toRecord());
+		}
+		if (!SceneFile::write(savePath, { SceneFile::section(SceneSectionType::WHEELS, records) })) {
+			cerr << "could not write " << savePath << endl;
+			return 1;
+		}
+	}
+
+	vector<GraphicObject2D*> wheels(built.begin(), built.end());
+	AnimationList animations;
+	for (PortraitWheel* wheel : built) {
+		animations.add(wheel);
+	}
+
+	// The pool takes a snapshot of the portraits; the wheel objects are then left alone
+	bool usePool = mode == "pool";
+	PortraitPool pool;
+	if (usePool) {
+		pool.reserve(portraitCount);
+		for (GraphicObject2D* wheel : wheels) {
+			pool.addWheel(*static_cast<PortraitWheel*>(wheel));
+		}
+	}
+
+	SoftwareRasterizer rasterizer(width, height, X_MIN, X_MAX, Y_MIN, Y_MAX, threads);
+	NullRenderContext nullContext;
+	nullContext.setPixelsPerUnit(rasterizer.getPixelsPerUnit());
+	nullContext.setViewBounds(rasterizer.getViewBounds());
+	RecordingRenderContext recorder;
+	recorder.setPixelsPerUnit(rasterizer.getPixelsPerUnit());
+	recorder.setViewBounds(rasterizer.getViewBounds());
+	bool raster = target == "raster";
+	bool record = target == "record";
+	bool draw = target != "none";
+	RenderContext& context = raster ? static_cast<RenderContext&>(rasterizer)
+		: record ? static_cast<RenderContext&>(recorder) : nullContext;
+
+	cout << "scene:         " << wheelCount << " wheels, " << portraitCount << " portraits\n"
+		<< "build:         " << buildMs << " ms on " << builders.getThreadCount() << " threads";
+	if (!scenePath.empty()) {
+		cout << " (scene file opened in " << openMs << " ms)";
+	}
+	cout << "\n"
+		<< "target:        " << target << " " << width << "x" << height << ", "
+		<< (raster || record ? rasterizer.getThreadCount() : 1) << " threads\n"
+		<< "mode:          " << mode;
+	if (usePool) {
+		cout << " (" << PortraitPool::getKernelName() << " kernels)";
+	}
+	cout << endl;
+
+	// One simulation tick of the interactive program per frame
+	const float tickSeconds = 0.016f;
+	BenchmarkStats stats, nullReplayStats, rasterReplayStats;
+	for (int frame = 0; frame < warmup + frames; frame++) {
+		if (frame >= warmup) {
+			stats.beginFrame();
+		}
+		if (raster) {
+			rasterizer.beginFrame();
+		}
+		if (record) {
+			recorder.clear();
+		}
+		if (usePool) {
+			if (draw) {
+				pool.draw(context);
+			}
+			pool.rotateWheels(PortraitWheel::ROTATION_SPEED * tickSeconds);
+		}
+		else {
+			if (draw) {
+				for (GraphicObject2D* wheel : wheels) {
+					if (context.isVisible(wheel->getBounds())) {
+						wheel->draw(context);
+					}
+				}
+			}
+			animations.update(tickSeconds);
+		}
+		if (raster) {
+			rasterizer.endFrame();
+		}
+		if (frame >= warmup) {
+			stats.endFrame();
+		}
+
+		// The captured frame, drawn again without walking the scene
+		if (record) {
+			bool measured = frame >= warmup;
+			if (measured) {
+				nullReplayStats.beginFrame();
+			}
+			recorder.replay(nullContext);
+			if (measured) {
+				nullReplayStats.endFrame();
+				rasterReplayStats.beginFrame();
+			}
+			rasterizer.beginFrame();
+			recorder.replay(rasterizer);
+			rasterizer.endFrame();
+			if (measured) {
+				rasterReplayStats.endFrame();
+			}
+		}
+
+		// Written after the frame's timings, so the image files don't count towards them
+		if (!outputPattern.empty() && frame >= warmup) {
+			SoftwareRasterizer::formatFramePath(outputPattern, frame - warmup, outputPath);
+			if (!rasterizer.writeImage(outputPath)) {
+				cerr << "could not write " << outputPath << endl;
+				return 1;
+			}
+		}
+	}
+
+	if (record) {
+		cout << "recorded:      " << recorder.getCommands().size() << " commands, " << recorder.getPrimitiveCount()
+			<< " primitives, " << recorder.getVertexCount() << " vertices per frame\n"
+			<< "-- recording (scene traversal only)\n";
+	}
+	stats.print(cout, portraitCount, "portraits");
+	if (record) {
+		cout << "-- replay into null\n";
+		nullReplayStats.print(cout, portraitCount, "portraits");
+		cout << "-- replay into raster\n";
+		rasterReplayStats.print(cout, portraitCount, "portraits");
+	}
+	return 0;
+}
@@ -0,0 +1,71 @@
+#include "BenchmarkStats.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+void BenchmarkStats::endFrame() {
+    auto elapsed = std::chrono::steady_clock::now() - frameStart_;
+    frameTimes_.push_back(std::chrono::duration<double, std::milli>(elapsed).count());
+}
+
+double BenchmarkStats::percentile(double percent) const {
+    if (frameTimes_.empty()) {
+        return 0.0;
+    }
+    std::vector<double> sorted(frameTimes_);
+    std::sort(sorted.begin(), sorted.end());
+
+    // Nearest rank: the smallest time that at least percent% of the frames don't exceed
+    size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * sorted.size()));
+    return sorted[std::min(std::max<size_t>(rank, 1), sorted.size()) - 1];
+}
+
+double BenchmarkStats::totalSeconds() const {
+    return std::accumulate(frameTimes_.begin(), frameTimes_.end(), 0.0) / 1000.0;
+}
+
+void BenchmarkStats::print(std::ostream& out, size_t objectsPerFrame, const char* objectName) const {
+    double seconds = totalSeconds();
+    double frames = static_cast<double>(frameTimes_.size());
+
+    out << "frames:        " << frameTimes_.size() << " in " << seconds << " s";
+    if (seconds > 0.0) {
+        out << " (" << frames / seconds << " fps)";
+    }
+    out << "\n";
+    out << "frame time ms: p50 " << percentile(50) << "  p90 " << percentile(90) << "  p99 " << percentile(99)
+        << "  max " << percentile(100) << "\n";
+    if (seconds > 0.0) {
+        out << "throughput:    " << objectsPerFrame * frames / seconds << " " << objectName << "/s\n";
+    }
+    out << "peak RSS:      " << peakResidentKB() / 1024.0 << " MB" << std::endl;
+}
+
+size_t BenchmarkStats::peakResidentKB() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize / 1024;
+    }
+    return 0;
+#else
+    // Linux reports ru_maxrss in kilobytes, macOS in bytes
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+        return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+        return static_cast<size_t>(usage.ru_maxrss);
+#endif
+    }
+    return 0;
+#endif
+}
@@ -0,0 +1,83 @@
+#ifndef BENCHMARKSTATS_H
+#define BENCHMARKSTATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+/**
+ * @class BenchmarkStats
+ * @brief Collects per-frame timings of a headless benchmark run and prints a summary.
+ *
+ * The summary has the frame-time percentiles, the sustained frame rate, the number of scene objects
+ * processed per second and the peak resident set size of the process, so runs on different machines
+ * and builds can be compared directly.
+ *
+ * @author Harrison Grenier
+ */
+class BenchmarkStats {
+public:
+    /**
+     * @brief Marks the start of a frame.
+     */
+    void beginFrame() { frameStart_ = std::chrono::steady_clock::now(); }
+
+    /**
+     * @brief Marks the end of the frame started by the last beginFrame() and records its duration.
+     */
+    void endFrame();
+
+    /**
+     * @brief Gets the number of frames recorded so far.
+     *
+     * @return The frame count.
+     */
+    size_t getFrameCount() const { return frameTimes_.size(); }
+
+    /**
+     * @brief Gets a frame-time percentile using the nearest-rank method.
+     *
+     * @param percent Percentile in [0, 100].
+     * @return Frame time in milliseconds, or 0 if no frame was recorded.
+     */
+    double percentile(double percent) const;
+
+    /**
+     * @brief Gets the total time spent in recorded frames.
+     *
+     * @return Total frame time in seconds.
+     */
+    double totalSeconds() const;
+
+    /**
+     * @brief Prints the summary.
+     *
+     * @param out Stream to print to.
+     * @param objectsPerFrame Number of scene objects drawn and updated in every frame.
+     * @param objectName Plural name of the objects, used in the output.
+     */
+    void print(std::ostream& out, size_t objectsPerFrame, const char* objectName) const;
+
+    /**
+     * @brief Gets the peak resident set size of the process so far.
+     *
+     * @return Peak RSS in kilobytes, or 0 if the platform doesn't report it.
+     */
+    static size_t peakResidentKB();
+
+private:
+    /**
+     * @var frameStart_
+     * @brief Time at which the current frame started.
+     */
+    std::chrono::steady_clock::time_point frameStart_;
+
+    /**
+     * @var frameTimes_
+     * @brief Duration of every recorded frame, in milliseconds.
+     */
+    std::vector<double> frameTimes_;
+};
+
+#endif // BENCHMARKSTATS_H
@@ -0,0 +1,126 @@
+#ifndef BOUNDINGBOX2D_H
+#define BOUNDINGBOX2D_H
+
+#include "Affine2D.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * @struct BoundingBox2D
+ * @brief Axis-aligned bounding box used for conservative visibility tests.
+ *
+ * An empty box has min > max and intersects nothing; an infinite box intersects everything and is
+ * used by objects that don't know their extent, so they are never culled by mistake.
+ *
+ * @author Harrison Grenier
+ */
+struct BoundingBox2D {
+    float minX; /**< Left edge */
+    float minY; /**< Bottom edge */
+    float maxX; /**< Right edge */
+    float maxY; /**< Top edge */
+
+    /**
+     * @brief Returns a box that contains nothing, ready to be grown with expand() or merge().
+     *
+     * @return The empty box.
+     */
+    static BoundingBox2D empty() {
+        const float inf = std::numeric_limits<float>::infinity();
+        return { inf, inf, -inf, -inf };
+    }
+
+    /**
+     * @brief Returns a box that contains everything.
+     *
+     * @return The infinite box.
+     */
+    static BoundingBox2D infinite() {
+        const float inf = std::numeric_limits<float>::infinity();
+        return { -inf, -inf, inf, inf };
+    }
+
+    /**
+     * @brief Tells whether the box contains no point at all.
+     *
+     * @return True if the box is empty.
+     */
+    bool isEmpty() const { return minX > maxX || minY > maxY; }
+
+    /**
+     * @brief Tells whether the box is unbounded.
+     *
+     * @return True if any edge is infinite.
+     */
+    bool isInfinite() const {
+        const float inf = std::numeric_limits<float>::infinity();
+        return minX == -inf || minY == -inf || maxX == inf || maxY == inf;
+    }
+
+    /**
+     * @brief Grows the box to contain a point.
+     *
+     * @param x X-coordinate of the point.
+     * @param y Y-coordinate of the point.
+     */
+    void expand(float x, float y) {
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+    }
+
+    /**
+     * @brief Grows the box to contain another box.
+     *
+     * @param other The box to include.
+     */
+    void merge(const BoundingBox2D& other) {
+        minX = std::min(minX, other.minX);
+        minY = std::min(minY, other.minY);
+        maxX = std::max(maxX, other.maxX);
+        maxY = std::max(maxY, other.maxY);
+    }
+
+    /**
+     * @brief Tells whether two boxes overlap (touching counts as overlapping).
+     *
+     * @param other The other box.
+     * @return True if the boxes share at least one point.
+     */
+    bool intersects(const BoundingBox2D& other) const {
+        return minX <= other.maxX && other.minX <= maxX && minY <= other.maxY && other.minY <= maxY;
+    }
+
+    /**
+     * @brief Tells whether a point lies inside the box.
+     *
+     * @param x X-coordinate of the point.
+     * @param y Y-coordinate of the point.
+     * @return True if the point is inside or on the edge.
+     */
+    bool contains(float x, float y) const { return x >= minX && x <= maxX && y >= minY && y <= maxY; }
+
+    /**
+     * @brief Returns the smallest axis-aligned box containing this box after a transformation.
+     *
+     * @param m The transformation to apply.
+     * @return The transformed box (empty and infinite boxes are returned unchanged).
+     */
+    BoundingBox2D transformed(const Affine2D& m) const {
+        if (isEmpty() || isInfinite()) {
+            return *this;
+        }
+        // The extent along each axis is the sum of the absolute contributions of the two half-sizes
+        float cx = 0.5f * (minX + maxX), cy = 0.5f * (minY + maxY);
+        float hx = 0.5f * (maxX - minX), hy = 0.5f * (maxY - minY);
+        float centerX, centerY;
+        m.apply(cx, cy, centerX, centerY);
+        float extentX = std::abs(m.a) * hx + std::abs(m.c) * hy;
+        float extentY = std::abs(m.b) * hx + std::abs(m.d) * hy;
+        return { centerX - extentX, centerY - extentY, centerX + extentX, centerY + extentY };
+    }
+};
+
+#endif // BOUNDINGBOX2D_H
@@ -0,0 +1,33 @@
+#include "FixedTimestep.h"
+#include <cmath>
+
+FixedTimestep::FixedTimestep(float stepSeconds, int maxSteps)
+    : stepSeconds_(stepSeconds), maxSteps_(maxSteps), accumulator_(0.0), lastTime_(std::chrono::steady_clock::now()) {
+}
+
+int FixedTimestep::advance() {
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - lastTime_).count();
+    lastTime_ = now;
+    return advance(elapsed);
+}
+
+int FixedTimestep::advance(double elapsedSeconds) {
+    accumulator_ += elapsedSeconds;
+    int steps = 0;
+    while (accumulator_ >= stepSeconds_ && steps < maxSteps_) {
+        accumulator_ -= stepSeconds_;
+        steps++;
+    }
+
+    // Too far behind to catch up: drop the whole steps that are left, keep the fraction
+    if (accumulator_ >= stepSeconds_) {
+        accumulator_ = std::fmod(accumulator_, stepSeconds_);
+    }
+    return steps;
+}
+
+void FixedTimestep::reset() {
+    accumulator_ = 0.0;
+    lastTime_ = std::chrono::steady_clock::now();
+}
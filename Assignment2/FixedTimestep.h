@@ -0,0 +1,91 @@
+#ifndef FIXEDTIMESTEP_H
+#define FIXEDTIMESTEP_H
+
+#include <chrono>
+
+/**
+ * @class FixedTimestep
+ * @brief Accumulator that turns measured real time into a whole number of fixed simulation steps.
+ *
+ * Every frame, advance() adds the time since the previous frame to an accumulator and returns how
+ * many steps of getStepSeconds() fit in it; the remainder carries over, and getAlpha() tells how
+ * far the display is between the last two steps so transforms can be interpolated. The simulation
+ * therefore runs at the same speed whatever the frame rate: slow frames run several steps, fast
+ * frames run none and just interpolate.
+ *
+ * @note To avoid a spiral where catching up makes frames ever slower, at most maxSteps steps run
+ *       per frame; time beyond that is dropped, and only then does the simulation fall behind.
+ *
+ * @author Harrison Grenier
+ */
+class FixedTimestep {
+public:
+    /**
+     * @brief Constructs a timestep that starts measuring now.
+     *
+     * @param stepSeconds Length of one simulation step in seconds.
+     * @param maxSteps Most steps run for a single frame.
+     */
+    explicit FixedTimestep(float stepSeconds, int maxSteps = 8);
+
+    /**
+     * @brief Measures the time since the previous call (or reset()) and consumes it.
+     *
+     * @return The number of steps to simulate this frame.
+     */
+    int advance();
+
+    /**
+     * @brief Consumes a given amount of time instead of measuring it.
+     *
+     * @param elapsedSeconds Time to add to the accumulator.
+     * @return The number of steps to simulate this frame.
+     */
+    int advance(double elapsedSeconds);
+
+    /**
+     * @brief Discards the accumulated time and restarts measuring now, e.g. when resuming from a pause.
+     */
+    void reset();
+
+    /**
+     * @brief Gets how far the current time is between the last step and the next one.
+     *
+     * @return Interpolation factor in [0, 1).
+     */
+    float getAlpha() const { return static_cast<float>(accumulator_ / stepSeconds_); }
+
+    /**
+     * @brief Gets the length of one simulation step.
+     *
+     * @return Step length in seconds.
+     */
+    float getStepSeconds() const { return static_cast<float>(stepSeconds_); }
+
+private:
+    /**
+     * @var stepSeconds_
+     * @brief Length of one simulation step in seconds.
+     */
+    double stepSeconds_;
+
+    /**
+     * @var maxSteps_
+     * @brief Most steps returned by a single advance().
+     */
+    int maxSteps_;
+
+    /**
+     * @var accumulator_
+     * @brief Measured time not yet consumed by steps, in seconds.
+     */
+    double accumulator_;
+
+    /**
+     * @var lastTime_
+     * @brief When advance() or reset() last measured the clock.
+     */
+    std::chrono::steady_clock::time_point lastTime_;
+};
+
+#endif // FIXEDTIMESTEP_H
@@ -0,0 +1,72 @@
+#include "GLRenderContext.h"
+#include "glPlatform.h"
+
+namespace {
+    // Translate our primitive type to the matching GL mode
+    GLenum glMode(PrimitiveType type) {
+        switch (type) {
+        case PrimitiveType::POLYGON: return GL_POLYGON;
+        case PrimitiveType::QUADS: return GL_QUADS;
+        case PrimitiveType::TRIANGLES: return GL_TRIANGLES;
+        case PrimitiveType::LINES: return GL_LINES;
+        case PrimitiveType::LINE_STRIP: return GL_LINE_STRIP;
+        case PrimitiveType::LINE_LOOP: return GL_LINE_LOOP;
+        }
+        return GL_POLYGON;
+    }
+}
+
+void GLRenderContext::setColor(float r, float g, float b) {
+    glColor3f(r, g, b);
+}
+
+void GLRenderContext::begin(PrimitiveType type) {
+    glBegin(glMode(type));
+}
+
+void GLRenderContext::vertex(float x, float y) {
+    glVertex2f(x, y);
+}
+
+void GLRenderContext::end() {
+    glEnd();
+}
+
+void GLRenderContext::drawVertices(PrimitiveType type, const float* xy, size_t count) {
+    // Hand the whole array over at once instead of one glVertex2f per point
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glVertexPointer(2, GL_FLOAT, 0, xy);
+    glDrawArrays(glMode(type), 0, static_cast<GLsizei>(count));
+    glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+void GLRenderContext::pushMatrix() {
+    glPushMatrix();
+}
+
+void GLRenderContext::popMatrix() {
+    glPopMatrix();
+}
+
+void GLRenderContext::translate(float x, float y) {
+    glTranslatef(x, y, 0.0f);
+}
+
+void GLRenderContext::rotate(float angle) {
+    glRotatef(angle, 0.0f, 0.0f, 1.0f);  // Rotate around the z-axis
+}
+
+void GLRenderContext::scale(float sx, float sy) {
+    glScalef(sx, sy, 1.0f);
+}
+
+void GLRenderContext::multMatrix(const Affine2D& m) {
+    // Expand the 3x2 matrix to OpenGL's column-major 4x4 layout
+    const GLfloat matrix[16] = {
+        m.a,  m.b,  0.0f, 0.0f,
+        m.c,  m.d,  0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f,
+        m.tx, m.ty, 0.0f, 1.0f
+    };
+    glMultMatrixf(matrix);
+}
@@ -0,0 +1,99 @@
+#include "GeometryRenderContext.h"
+
+GeometryRenderContext::GeometryRenderContext()
+    : matrix_(Affine2D::identity()), color_{ 1.0f, 1.0f, 1.0f }, primitive_(PrimitiveType::POLYGON) {
+}
+
+void GeometryRenderContext::setColor(float r, float g, float b) {
+    color_ = { r, g, b };
+}
+
+void GeometryRenderContext::begin(PrimitiveType type) {
+    primitive_ = type;
+    points_.clear();
+}
+
+void GeometryRenderContext::vertex(float x, float y) {
+    points_.push_back(x);
+    points_.push_back(y);
+}
+
+void GeometryRenderContext::end() {
+    // Transform the whole primitive at once, in place
+    size_t n = points_.size() / 2;
+    matrix_.transformPoints(points_.data(), points_.data(), n);
+    auto v = [this](size_t i) { return GeometryVertex{ points_[2 * i], points_[2 * i + 1] }; };
+
+    switch (primitive_) {
+    case PrimitiveType::POLYGON:
+        // Convex polygon: fan around the first vertex
+        for (size_t i = 1; i + 1 < n; i++) {
+            emitTriangle(v(0), v(i), v(i + 1), color_);
+        }
+        break;
+    case PrimitiveType::QUADS:
+        for (size_t i = 0; i + 3 < n; i += 4) {
+            emitTriangle(v(i), v(i + 1), v(i + 2), color_);
+            emitTriangle(v(i), v(i + 2), v(i + 3), color_);
+        }
+        break;
+    case PrimitiveType::TRIANGLES:
+        for (size_t i = 0; i + 2 < n; i += 3) {
+            emitTriangle(v(i), v(i + 1), v(i + 2), color_);
+        }
+        break;
+    case PrimitiveType::LINES:
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            emitLine(v(i), v(i + 1), color_);
+        }
+        break;
+    case PrimitiveType::LINE_STRIP:
+    case PrimitiveType::LINE_LOOP:
+        for (size_t i = 0; i + 1 < n; i++) {
+            emitLine(v(i), v(i + 1), color_);
+        }
+        if (primitive_ == PrimitiveType::LINE_LOOP && n > 2) {
+            emitLine(v(n - 1), v(0), color_);  // close the loop
+        }
+        break;
+    }
+    points_.clear();
+}
+
+void GeometryRenderContext::drawVertices(PrimitiveType type, const float* xy, size_t count) {
+    primitive_ = type;
+    points_.assign(xy, xy + 2 * count);
+    end();
+}
+
+void GeometryRenderContext::pushMatrix() {
+    matrixStack_.push_back(matrix_);
+}
+
+void GeometryRenderContext::popMatrix() {
+    if (!matrixStack_.empty()) {
+        matrix_ = matrixStack_.back();
+        matrixStack_.pop_back();
+    }
+}
+
+void GeometryRenderContext::translate(float x, float y) {
+    matrix_ = matrix_ * Affine2D::translation(x, y);  // post-multiply, like glTranslatef
+}
+
+void GeometryRenderContext::rotate(float angle) {
+    matrix_ = matrix_ * Affine2D::rotation(angle);
+}
+
+void GeometryRenderContext::scale(float sx, float sy) {
+    matrix_ = matrix_ * Affine2D::scaling(sx, sy);
+}
+
+void GeometryRenderContext::multMatrix(const Affine2D& m) {
+    matrix_ = matrix_ * m;
+}
+
+void GeometryRenderContext::resetMatrix() {
+    matrix_ = Affine2D::identity();
+    matrixStack_.clear();
+}
@@ -0,0 +1,131 @@
+#ifndef GEOMETRYRENDERCONTEXT_H
+#define GEOMETRYRENDERCONTEXT_H
+
+#include "RenderContext.h"
+#include "Affine2D.h"
+#include <vector>
+
+/**
+ * @struct GeometryVertex
+ * @brief A vertex after the model transformation has been applied (world coordinates).
+ */
+struct GeometryVertex {
+    float x; /**< World X-coordinate */
+    float y; /**< World Y-coordinate */
+};
+
+/**
+ * @struct GeometryColor
+ * @brief An RGB color with components in [0, 1].
+ */
+struct GeometryColor {
+    float r; /**< Red color component */
+    float g; /**< Green color component */
+    float b; /**< Blue color component */
+};
+
+/**
+ * @class GeometryRenderContext
+ * @brief RenderContext that transforms on the CPU and breaks every primitive into triangles and lines.
+ *
+ * This base class keeps its own model matrix stack, applies it to each primitive's vertices in one
+ * batch when the primitive ends, and turns polygons,
+ * quads and triangles into independent triangles and line strips/loops into independent segments.
+ * Subclasses only have to consume the resulting world-space triangles and segments, in submission
+ * order, through emitTriangle and emitLine.
+ *
+ * @note Polygons are assumed to be convex, as in OpenGL.
+ *
+ * @see RenderContext
+ *
+ * @author Harrison Grenier
+ */
+class GeometryRenderContext : public RenderContext {
+public:
+    /**
+     * @brief Constructs a context with an identity model matrix and white as the current color.
+     */
+    GeometryRenderContext();
+
+    /** @brief Sets the color of the following primitives. */
+    void setColor(float r, float g, float b) override;
+    /** @brief Starts collecting the vertices of a primitive. */
+    void begin(PrimitiveType type) override;
+    /** @brief Collects the vertex (in model space). */
+    void vertex(float x, float y) override;
+    /** @brief Transforms the collected vertices and emits them as triangles or segments. */
+    void end() override;
+    /** @brief Collects the whole array at once, then ends the primitive. */
+    void drawVertices(PrimitiveType type, const float* xy, size_t count) override;
+    /** @brief Saves the current model matrix. */
+    void pushMatrix() override;
+    /** @brief Restores the last saved model matrix. */
+    void popMatrix() override;
+    /** @brief Appends a translation to the model matrix. */
+    void translate(float x, float y) override;
+    /** @brief Appends a rotation (degrees) to the model matrix. */
+    void rotate(float angle) override;
+    /** @brief Appends a scale to the model matrix. */
+    void scale(float sx, float sy) override;
+    /** @brief Appends an arbitrary transformation to the model matrix. */
+    void multMatrix(const Affine2D& m) override;
+
+protected:
+    /**
+     * @brief Receives one filled triangle, in world coordinates.
+     *
+     * @param a First vertex.
+     * @param b Second vertex.
+     * @param c Third vertex.
+     * @param color Fill color.
+     */
+    virtual void emitTriangle(const GeometryVertex& a, const GeometryVertex& b, const GeometryVertex& c,
+                              const GeometryColor& color) = 0;
+
+    /**
+     * @brief Receives one line segment, in world coordinates.
+     *
+     * @param a Start of the segment.
+     * @param b End of the segment.
+     * @param color Line color.
+     */
+    virtual void emitLine(const GeometryVertex& a, const GeometryVertex& b, const GeometryColor& color) = 0;
+
+    /**
+     * @brief Resets the model matrix stack to identity, e.g. at the start of a frame.
+     */
+    void resetMatrix();
+
+private:
+    /**
+     * @var matrix_
+     * @brief The current model matrix.
+     */
+    Affine2D matrix_;
+
+    /**
+     * @var matrixStack_
+     * @brief Matrices saved by pushMatrix.
+     */
+    std::vector<Affine2D> matrixStack_;
+
+    /**
+     * @var color_
+     * @brief The current color.
+     */
+    GeometryColor color_;
+
+    /**
+     * @var primitive_
+     * @brief Type of the primitive being collected.
+     */
+    PrimitiveType primitive_;
+
+    /**
+     * @var points_
+     * @brief Interleaved x, y coordinates of the primitive being collected.
+     */
+    std::vector<float> points_;
+};
+
+#endif // GEOMETRYRENDERCONTEXT_H
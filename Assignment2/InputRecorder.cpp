@@ -0,0 +1,169 @@
+#include "InputRecorder.h"
+#include <cstring>
+
+namespace {
+    const char MAGIC[8] = { 'A', '2', 'I', 'N', 'P', 'U', 'T', '\0' };
+
+    // Fixed-size file header, followed by the events
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+    };
+
+    // Events buffered before they are written out
+    const size_t FLUSH_THRESHOLD = 4096;
+}
+
+InputRecorder::InputRecorder()
+    : file_(nullptr), writeOk_(true), next_(0), maxSpeed_(false), started_(false) {
+}
+
+InputRecorder::~InputRecorder() {
+    stopRecording();
+}
+
+bool InputRecorder::startRecording(const std::string& path) {
+    stopRecording();
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        return false;
+    }
+
+    FileHeader header = {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    writeOk_ = std::fwrite(&header, sizeof(header), 1, file_) == 1;
+    start_ = std::chrono::steady_clock::now();
+    return writeOk_;
+}
+
+bool InputRecorder::stopRecording() {
+    if (!file_) {
+        return true;
+    }
+    flush();
+    bool ok = std::fclose(file_) == 0 && writeOk_;
+    file_ = nullptr;
+    return ok;
+}
+
+void InputRecorder::recordKeyboard(unsigned char key, int x, int y) {
+    append({ 0, InputEventType::KEYBOARD, key, 0, 0, x, y });
+}
+
+void InputRecorder::recordMouse(int button, int state, int x, int y) {
+    append({ 0, InputEventType::MOUSE, 0, static_cast<uint8_t>(button), static_cast<uint8_t>(state), x, y });
+}
+
+void InputRecorder::recordMotion(int x, int y) {
+    append({ 0, InputEventType::MOTION, 0, 0, 0, x, y });
+}
+
+void InputRecorder::recordResize(int width, int height) {
+    append({ 0, InputEventType::RESIZE, 0, 0, 0, width, height });
+}
+
+void InputRecorder::recordTicks(int count) {
+    if (count > 0) {
+        append({ 0, InputEventType::TICKS, 0, 0, 0, count, 0 });
+    }
+}
+
+void InputRecorder::append(InputEvent event) {
+    if (!file_) {
+        return;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    event.time = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    pending_.push_back(event);
+    if (pending_.size() >= FLUSH_THRESHOLD) {
+        flush();
+    }
+}
+
+bool InputRecorder::flush() {
+    if (!pending_.empty()) {
+        writeOk_ = std::fwrite(pending_.data(), sizeof(InputEvent), pending_.size(), file_) == pending_.size() && writeOk_;
+        pending_.clear();
+    }
+    return writeOk_;
+}
+
+bool InputRecorder::loadReplay(const std::string& path, bool maxSpeed) {
+    events_.clear();
+    next_ = 0;
+    started_ = false;
+    maxSpeed_ = maxSpeed;
+    error_.clear();
+
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        error_ = path + ": cannot open";
+        return false;
+    }
+
+    FileHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        error_ = path + ": not an input log";
+    }
+    else if (header.version > VERSION) {
+        error_ = path + ": version " + std::to_string(header.version) + " is newer than " + std::to_string(VERSION);
+    }
+    else {
+        // Read whole events until the end; a partly written last event is dropped
+        InputEvent event;
+        while (std::fread(&event, sizeof(event), 1, file) == 1) {
+            if (event.type < InputEventType::KEYBOARD || event.type > InputEventType::TICKS) {
+                error_ = path + ": unknown event type " + std::to_string(static_cast<int>(event.type));
+                events_.clear();
+                break;
+            }
+            events_.push_back(event);
+        }
+    }
+    std::fclose(file);
+    return error_.empty();
+}
+
+size_t InputRecorder::replay(const InputHandlers& handlers) {
+    if (!started_) {
+        start_ = std::chrono::steady_clock::now();
+        started_ = true;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+
+    size_t first = next_;
+    while (next_ < events_.size()) {
+        const InputEvent& event = events_[next_];
+        if (!maxSpeed_ && event.time > now) {
+            break;
+        }
+        next_++;
+
+        switch (event.type) {
+        case InputEventType::KEYBOARD:
+            if (handlers.keyboard) handlers.keyboard(event.key, event.x, event.y);
+            break;
+        case InputEventType::MOUSE:
+            if (handlers.mouse) handlers.mouse(event.button, event.state, event.x, event.y);
+            break;
+        case InputEventType::MOTION:
+            if (handlers.motion) handlers.motion(event.x, event.y);
+            break;
+        case InputEventType::RESIZE:
+            if (handlers.resize) handlers.resize(event.x, event.y);
+            break;
+        case InputEventType::TICKS:
+            if (handlers.ticks) handlers.ticks(event.x);
+            break;
+        }
+
+        // At maximum speed every call ends after one batch of ticks, so each gets drawn
+        if (maxSpeed_ && event.type == InputEventType::TICKS) {
+            break;
+        }
+    }
+    return next_ - first;
+}
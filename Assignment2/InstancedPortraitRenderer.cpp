@@ -0,0 +1,228 @@
+#include <GL/glew.h>  // must come before the other OpenGL headers
+#include "glPlatform.h"
+#include "InstancedPortraitRenderer.h"
+#include "ComplexGraphicObject2D.h"
+#include "PortraitMesh.h"
+#include "Portrait.h"
+#include "Logger.h"
+#include <cmath>
+#include <cstddef>
+
+using namespace std;
+
+namespace {
+    // Vertex attribute slots shared by the shaders and the buffer setup
+    const GLuint ATTRIB_POSITION = 0;
+    const GLuint ATTRIB_COLOR = 1;
+    const GLuint ATTRIB_INSTANCE = 2;
+    const GLuint ATTRIB_TINT = 3;
+    const GLuint ATTRIB_HAT = 4;
+    const GLuint ATTRIB_HAT_OFFSET = 5;
+
+    // Raises the hat body by the instance's hat offset, rotates and scales the unit mesh by the
+    // instance, then applies the fixed-function projection
+    const char* VERTEX_SHADER =
+        "#version 130\n"
+        "in vec2 vertexPosition;\n"
+        "in vec3 vertexColor;\n"
+        "in float vertexHat;\n"
+        "in vec4 instanceTransform;\n"  // x, y, orientation (degrees), scale
+        "in vec3 instanceTint;\n"
+        "in float instanceHatOffset;\n"
+        "out vec3 color;\n"
+        "void main() {\n"
+        "    float angle = radians(instanceTransform.z);\n"
+        "    float c = cos(angle);\n"
+        "    float s = sin(angle);\n"
+        "    vec2 p = (vertexPosition + vec2(0.0, vertexHat * instanceHatOffset)) * instanceTransform.w;\n"
+        "    vec2 world = vec2(c * p.x - s * p.y, s * p.x + c * p.y) + instanceTransform.xy;\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * vec4(world, 0.0, 1.0);\n"
+        "    color = vertexColor * instanceTint;\n"
+        "}\n";
+
+    const char* FRAGMENT_SHADER =
+        "#version 130\n"
+        "in vec3 color;\n"
+        "void main() {\n"
+        "    gl_FragColor = vec4(color, 1.0);\n"
+        "}\n";
+
+    GLuint compileShader(GLenum type, const char* source) {
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+
+        GLint ok = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (!ok) {
+            char log[1024];
+            glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+            LOG_ERROR("InstancedPortraitRenderer: shader compile failed: %s", log);
+            glDeleteShader(shader);
+            return 0;
+        }
+        return shader;
+    }
+}
+
+InstancedPortraitRenderer::InstancedPortraitRenderer()
+    : ready_(false), program_(0), meshBuffer_(0), instanceBuffer_(0), instanceCapacity_(0), meshVertexCount_(0),
+    viewBounds_(BoundingBox2D::infinite()) {
+}
+
+InstancedPortraitRenderer::~InstancedPortraitRenderer() {
+    if (ready_) {
+        glDeleteBuffers(1, &meshBuffer_);
+        glDeleteBuffers(1, &instanceBuffer_);
+        glDeleteProgram(program_);
+    }
+}
+
+bool InstancedPortraitRenderer::initialize() {
+    if (ready_) {
+        return true;
+    }
+
+    if (glewInit() != GLEW_OK) {
+        LOG_ERROR("InstancedPortraitRenderer: glewInit failed");
+        return false;
+    }
+    if (!GLEW_VERSION_3_3) {
+        LOG_WARNING("InstancedPortraitRenderer: OpenGL 3.3 is required for instancing");
+        return false;
+    }
+
+    // Build the shader program
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, VERTEX_SHADER);
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+    if (vertexShader == 0 || fragmentShader == 0) {
+        glDeleteShader(vertexShader);
+        glDeleteShader(fragmentShader);
+        return false;
+    }
+    program_ = glCreateProgram();
+    glAttachShader(program_, vertexShader);
+    glAttachShader(program_, fragmentShader);
+    glBindAttribLocation(program_, ATTRIB_POSITION, "vertexPosition");
+    glBindAttribLocation(program_, ATTRIB_COLOR, "vertexColor");
+    glBindAttribLocation(program_, ATTRIB_INSTANCE, "instanceTransform");
+    glBindAttribLocation(program_, ATTRIB_TINT, "instanceTint");
+    glBindAttribLocation(program_, ATTRIB_HAT, "vertexHat");
+    glBindAttribLocation(program_, ATTRIB_HAT_OFFSET, "instanceHatOffset");
+    glLinkProgram(program_);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program_, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char log[1024];
+        glGetProgramInfoLog(program_, sizeof(log), nullptr, log);
+        LOG_ERROR("InstancedPortraitRenderer: program link failed: %s", log);
+        glDeleteProgram(program_);
+        program_ = 0;
+        return false;
+    }
+
+    // Upload the shared portrait mesh once
+    const vector<MeshVertex>& mesh = PortraitMesh::get();
+    meshVertexCount_ = static_cast<int>(mesh.size());
+    glGenBuffers(1, &meshBuffer_);
+    glBindBuffer(GL_ARRAY_BUFFER, meshBuffer_);
+    glBufferData(GL_ARRAY_BUFFER, mesh.size() * sizeof(MeshVertex), mesh.data(), GL_STATIC_DRAW);
+
+    glGenBuffers(1, &instanceBuffer_);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    ready_ = true;
+    return true;
+}
+
+void InstancedPortraitRenderer::collectInstances(const GraphicObject2D& object, const Affine2D& parentSpace) {
+    // Skip whole wheels (and single portraits) that are off screen
+    if (!viewBounds_.intersects(object.getLocalBounds().transformed(parentSpace * object.getTransform()))) {
+        return;
+    }
+
+    if (const portrait* face = dynamic_cast<const portrait*>(&object)) {
+        // Compose with the parents, then read back position, orientation and uniform scale.
+        // portrait::draw scales by getScale() and then draws at size_, the mesh is at size 1
+        // with the hat body where it sits for that size
+        Affine2D world = parentSpace * face->getTransform();
+        float scale = std::sqrt(world.a * world.a + world.b * world.b);
+        float orientation = std::atan2(world.b, world.a) * (180.0f / 3.1415926f);
+        instances_.push_back({ world.tx, world.ty, orientation, scale * face->getSize(),
+                               face->getTintR(), face->getTintG(), face->getTintB(),
+                               PortraitPrototype::hatOffset(face->getSize()) });
+    }
+    else if (const ComplexGraphicObject2D* complex = dynamic_cast<const ComplexGraphicObject2D*>(&object)) {
+        for (size_t i = 0; i < complex->getPartCount(); i++) {
+            if (const GraphicObject2D* part = complex->getPart(i)) {
+                collectInstances(*part, parentSpace * complex->getPartSpace(i));
+            }
+        }
+    }
+}
+
+void InstancedPortraitRenderer::draw(const vector<GraphicObject2D*>& objects) {
+    if (!ready_) {
+        return;
+    }
+
+    instances_.clear();
+    for (const auto& obj : objects) {
+        if (obj) {
+            collectInstances(*obj, Affine2D::identity());
+        }
+    }
+    if (instances_.empty()) {
+        return;
+    }
+
+    // Stream the instance placements, growing the buffer only when the scene outgrows it
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer_);
+    if (instances_.size() > instanceCapacity_) {
+        instanceCapacity_ = instances_.size() * 2;
+        glBufferData(GL_ARRAY_BUFFER, instanceCapacity_ * sizeof(PortraitInstance), nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instances_.size() * sizeof(PortraitInstance), instances_.data());
+    glVertexAttribPointer(ATTRIB_INSTANCE, 4, GL_FLOAT, GL_FALSE, sizeof(PortraitInstance),
+                          reinterpret_cast<const void*>(offsetof(PortraitInstance, x)));
+    glVertexAttribPointer(ATTRIB_TINT, 3, GL_FLOAT, GL_FALSE, sizeof(PortraitInstance),
+                          reinterpret_cast<const void*>(offsetof(PortraitInstance, tintR)));
+    glVertexAttribPointer(ATTRIB_HAT_OFFSET, 1, GL_FLOAT, GL_FALSE, sizeof(PortraitInstance),
+                          reinterpret_cast<const void*>(offsetof(PortraitInstance, hatOffset)));
+    glVertexAttribDivisor(ATTRIB_INSTANCE, 1);
+    glVertexAttribDivisor(ATTRIB_TINT, 1);
+    glVertexAttribDivisor(ATTRIB_HAT_OFFSET, 1);
+    glEnableVertexAttribArray(ATTRIB_INSTANCE);
+    glEnableVertexAttribArray(ATTRIB_TINT);
+    glEnableVertexAttribArray(ATTRIB_HAT_OFFSET);
+
+    glBindBuffer(GL_ARRAY_BUFFER, meshBuffer_);
+    glVertexAttribPointer(ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+                          reinterpret_cast<const void*>(offsetof(MeshVertex, x)));
+    glVertexAttribPointer(ATTRIB_COLOR, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+                          reinterpret_cast<const void*>(offsetof(MeshVertex, r)));
+    glVertexAttribPointer(ATTRIB_HAT, 1, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
+                          reinterpret_cast<const void*>(offsetof(MeshVertex, hat)));
+    glEnableVertexAttribArray(ATTRIB_POSITION);
+    glEnableVertexAttribArray(ATTRIB_COLOR);
+    glEnableVertexAttribArray(ATTRIB_HAT);
+
+    glUseProgram(program_);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, meshVertexCount_, static_cast<GLsizei>(instances_.size()));
+    glUseProgram(0);
+
+    // Leave the fixed-function state as the immediate-mode path expects it
+    glDisableVertexAttribArray(ATTRIB_POSITION);
+    glDisableVertexAttribArray(ATTRIB_COLOR);
+    glDisableVertexAttribArray(ATTRIB_INSTANCE);
+    glDisableVertexAttribArray(ATTRIB_TINT);
+    glDisableVertexAttribArray(ATTRIB_HAT);
+    glDisableVertexAttribArray(ATTRIB_HAT_OFFSET);
+    glVertexAttribDivisor(ATTRIB_INSTANCE, 0);
+    glVertexAttribDivisor(ATTRIB_TINT, 0);
+    glVertexAttribDivisor(ATTRIB_HAT_OFFSET, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,141 @@
+#ifndef INSTANCEDPORTRAITRENDERER_H
+#define INSTANCEDPORTRAITRENDERER_H
+
+#include "GraphicObject2D.h"
+#include <vector>
+
+/**
+ * @struct PortraitInstance
+ * @brief Per-instance placement of one portrait: position, orientation and scale, plus its tint and hat offset.
+ */
+struct PortraitInstance {
+    float x;           /**< X-coordinate of the portrait's position */
+    float y;           /**< Y-coordinate of the portrait's position */
+    float orientation; /**< Orientation of the portrait in degrees */
+    float scale;       /**< Uniform scale applied to the unit-space portrait mesh */
+    float tintR;       /**< Red factor applied to the mesh colors */
+    float tintG;       /**< Green factor applied to the mesh colors */
+    float tintB;       /**< Blue factor applied to the mesh colors */
+    float hatOffset;   /**< Unit-space shift of the hat body, from PortraitPrototype::hatOffset() */
+};
+
+/**
+ * @class InstancedPortraitRenderer
+ * @brief Retained-mode renderer that draws every portrait of every wheel with one instanced call.
+ *
+ * The unit-space PortraitMesh is uploaded to a vertex buffer once. Each frame the renderer gathers
+ * one PortraitInstance per portrait, streams them into a second buffer, and issues a single
+ * glDrawArraysInstanced call. Only OpenGL 3.3 features (GLSL 1.30, attribute divisors) are used,
+ * so the path runs on Mesa's llvmpipe as well as on real GPUs.
+ *
+ * @note initialize() must be called after the GLUT window (and its GL context) exists.
+ *
+ * @see PortraitMesh
+ * @see PortraitWheel
+ *
+ * @author Harrison Grenier
+ */
+class InstancedPortraitRenderer {
+public:
+    /**
+     * @brief Constructs an uninitialized renderer. No GL calls are made until initialize().
+     */
+    InstancedPortraitRenderer();
+
+    /**
+     * @brief Releases the GL buffers and shader program.
+     */
+    ~InstancedPortraitRenderer();
+
+    InstancedPortraitRenderer(const InstancedPortraitRenderer&) = delete;
+    InstancedPortraitRenderer& operator=(const InstancedPortraitRenderer&) = delete;
+
+    /**
+     * @brief Loads the GL entry points, compiles the shaders and uploads the portrait mesh.
+     *
+     * @return True if the current context supports instancing and setup succeeded.
+     */
+    bool initialize();
+
+    /**
+     * @brief Tells whether initialize() succeeded and draw() can be used.
+     *
+     * @return True if the renderer is ready.
+     */
+    bool isReady() const { return ready_; }
+
+    /**
+     * @brief Sets the visible world region; portraits and wheels outside it are not collected.
+     *
+     * @param bounds The visible region, or BoundingBox2D::infinite() to disable culling.
+     */
+    void setViewBounds(const BoundingBox2D& bounds) { viewBounds_ = bounds; }
+
+    /**
+     * @brief Draws the portraits of all the given objects with a single instanced draw call.
+     *
+     * Portraits are found inside ComplexGraphicObject2D parts as well as at the top level.
+     *
+     * @param objects The objects to draw.
+     */
+    void draw(const std::vector<GraphicObject2D*>& objects);
+
+private:
+    /**
+     * @brief Appends the instance of the given object, or of its parts if it is a composite.
+     *
+     * @param object Object to collect portrait instances from.
+     * @param parentSpace Transformation from the object's parent space to world space.
+     */
+    void collectInstances(const GraphicObject2D& object, const Affine2D& parentSpace);
+
+    /**
+     * @var ready_
+     * @brief True once initialize() has succeeded.
+     */
+    bool ready_;
+
+    /**
+     * @var program_
+     * @brief GL shader program name.
+     */
+    unsigned int program_;
+
+    /**
+     * @var meshBuffer_
+     * @brief GL buffer holding the unit-space portrait mesh.
+     */
+    unsigned int meshBuffer_;
+
+    /**
+     * @var instanceBuffer_
+     * @brief GL buffer holding the per-instance placements, refilled every frame.
+     */
+    unsigned int instanceBuffer_;
+
+    /**
+     * @var instanceCapacity_
+     * @brief Number of instances the instance buffer can currently hold.
+     */
+    size_t instanceCapacity_;
+
+    /**
+     * @var meshVertexCount_
+     * @brief Number of vertices in the uploaded mesh.
+     */
+    int meshVertexCount_;
+
+    /**
+     * @var instances_
+     * @brief CPU-side staging array for the instance buffer, reused between frames.
+     */
+    std::vector<PortraitInstance> instances_;
+
+    /**
+     * @var viewBounds_
+     * @brief Visible world region used to reject objects before they are collected.
+     */
+    BoundingBox2D viewBounds_;
+};
+
+#endif // INSTANCEDPORTRAITRENDERER_H
@@ -0,0 +1,29 @@
+#include "LevelOfDetail.h"
+#include <cmath>
+
+int LevelOfDetail::ellipseSegments(float radiusPixels, int maxSegments) {
+    if (radiusPixels <= 0.0f) {
+        return maxSegments;  // no viewport information, keep full detail
+    }
+
+    // Each segment spans 2*pi/n; its chord deviates from the arc by r * (1 - cos(pi/n))
+    float needed = MIN_SEGMENTS;
+    if (radiusPixels > MAX_ERROR_PIXELS) {
+        needed = 3.1415926f / std::acos(1.0f - MAX_ERROR_PIXELS / radiusPixels);
+    }
+
+    // Round up to a fixed set of levels so only a few unit-circle tables are ever built
+    for (int level : LEVELS) {
+        if (level >= needed || level >= maxSegments) {
+            return level < maxSegments ? level : maxSegments;
+        }
+    }
+    return maxSegments;
+}
+
+float LevelOfDetail::stableScale(float pixelScale, float& lastScale) {
+    if (lastScale <= 0.0f || std::fabs(pixelScale - lastScale) > HYSTERESIS * lastScale) {
+        lastScale = pixelScale;
+    }
+    return lastScale;
+}
@@ -0,0 +1,71 @@
+#ifndef LEVELOFDETAIL_H
+#define LEVELOFDETAIL_H
+
+/**
+ * @class LevelOfDetail
+ * @brief Screen-space tessellation level selection for ellipses.
+ *
+ * An ellipse only needs enough segments for the chord between two neighboring points to stay
+ * within a fraction of a pixel of the true curve. This class turns a projected radius in pixels
+ * into such a segment count, rounded up to a small fixed set of levels so the unit-circle cache
+ * only ever holds a few tables, and provides the hysteresis used to keep the chosen level from
+ * flickering when an object's on-screen size hovers around a threshold.
+ *
+ * @see UnitCircle
+ *
+ * @author Harrison Grenier
+ */
+class LevelOfDetail {
+public:
+    /**
+     * @brief Chooses the number of segments for an ellipse of the given on-screen radius.
+     *
+     * @param radiusPixels The larger semi-axis of the ellipse, in pixels. 0 or less means unknown.
+     * @param maxSegments The segment count used at full detail; the result never exceeds it.
+     * @return A segment count between MIN_SEGMENTS and maxSegments.
+     */
+    static int ellipseSegments(float radiusPixels, int maxSegments);
+
+    /**
+     * @brief Applies hysteresis to a pixel scale before it is used for level selection.
+     *
+     * The previously used scale is kept until the new one differs from it by more than
+     * HYSTERESIS (relative), at which point the new value is adopted.
+     *
+     * @param pixelScale The current number of pixels per local unit.
+     * @param lastScale The scale used last time; updated when the scale is adopted.
+     * @return The scale to select levels with.
+     */
+    static float stableScale(float pixelScale, float& lastScale);
+
+    /**
+     * @var MIN_SEGMENTS
+     * @brief Fewest segments ever used for an ellipse.
+     */
+    static const int MIN_SEGMENTS = 8;
+
+    /**
+     * @var MAX_ERROR_PIXELS
+     * @brief Largest allowed distance, in pixels, between a chord and the true curve.
+     */
+    static constexpr float MAX_ERROR_PIXELS = 0.25f;
+
+    /**
+     * @var HYSTERESIS
+     * @brief Relative change in pixel scale needed before a new level is selected.
+     */
+    static constexpr float HYSTERESIS = 0.2f;
+
+    /**
+     * @var LEVELS
+     * @brief The segment counts ellipseSegments() rounds up to, below a shape's own maximum.
+     */
+    static constexpr int LEVELS[] = { MIN_SEGMENTS, 12, 16, 24, 32, 48, 64, 100, 128, 200 };
+
+    /**
+     * @brief Deleted constructor, the class only exposes static helpers.
+     */
+    LevelOfDetail() = delete;
+};
+
+#endif // LEVELOFDETAIL_H
@@ -0,0 +1,145 @@
+#include "Logger.h"
+#include <cctype>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+
+std::atomic<int> Logger::threshold_{ static_cast<int>(LogLevel::INFO) };
+
+namespace {
+    // Pick up LOG_LEVEL before main runs
+    [[maybe_unused]] const bool levelFromEnvironment = (Logger::setLevel(Logger::parseLevel(std::getenv("LOG_LEVEL"), LogLevel::INFO)), true);
+
+    const char* levelName(LogLevel level) {
+        switch (level) {
+        case LogLevel::DEBUG: return "debug";
+        case LogLevel::INFO: return "info";
+        case LogLevel::WARNING: return "warning";
+        case LogLevel::ERR: return "error";
+        default: return "off";
+        }
+    }
+}
+
+Logger& Logger::instance() {
+    // Function-local static: created with the first message, destroyed (and drained) at exit
+    static Logger logger;
+    return logger;
+}
+
+LogLevel Logger::parseLevel(const char* name, LogLevel fallback) {
+    if (name == nullptr) {
+        return fallback;
+    }
+    for (LogLevel level : { LogLevel::DEBUG, LogLevel::INFO, LogLevel::WARNING, LogLevel::ERR, LogLevel::OFF }) {
+        const char* expected = levelName(level);
+        size_t i = 0;
+        while (name[i] && expected[i] && std::tolower(static_cast<unsigned char>(name[i])) == expected[i]) {
+            i++;
+        }
+        if (name[i] == '\0' && expected[i] == '\0') {
+            return level;
+        }
+    }
+    return fallback;
+}
+
+Logger::Logger()
+    : slots_(new Slot[CAPACITY]), head_(0), tail_(0), dropped_(0), running_(true) {
+    for (size_t i = 0; i < CAPACITY; i++) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    drainThread_ = std::thread(&Logger::drainLoop, this);
+}
+
+Logger::~Logger() {
+    running_.store(false);
+    drainThread_.join();
+}
+
+void Logger::log(LogLevel level, const char* format, ...) {
+    // Claim a slot: it is free for this position when its sequence equals the position
+    size_t position = head_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots_[position & (CAPACITY - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence == position) {
+            if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (sequence < position) {
+            // The drain thread hasn't freed this slot yet, so the ring is full
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else {
+            position = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->level = level;
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(slot->text, MESSAGE_SIZE, format, args);
+    va_end(args);
+
+    // Hand the slot to the drain thread
+    slot->sequence.store(position + 1, std::memory_order_release);
+}
+
+void Logger::flush() {
+    size_t target = head_.load(std::memory_order_acquire);
+    while (tail_.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void Logger::drainLoop() {
+    while (running_.load()) {
+        if (drain() == 0) {
+            // Nothing queued: poll again shortly rather than make every producer signal us
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+
+    // Write whatever was logged before shutdown
+    while (drain() > 0) {
+    }
+    uint64_t dropped = getDroppedCount();
+    if (dropped > 0) {
+        std::fprintf(stderr, "[warning] logger dropped %llu messages\n", static_cast<unsigned long long>(dropped));
+    }
+}
+
+size_t Logger::drain() {
+    size_t written = 0;
+    bool wroteOut = false, wroteErr = false;
+    size_t position = tail_.load(std::memory_order_relaxed);
+
+    for (;;) {
+        Slot& slot = slots_[position & (CAPACITY - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1) {
+            break;  // next message not complete yet
+        }
+
+        bool important = slot.level >= LogLevel::WARNING;
+        FILE* stream = important ? stderr : stdout;
+        std::fprintf(stream, "[%s] %s\n", levelName(slot.level), slot.text);
+        (important ? wroteErr : wroteOut) = true;
+
+        // Free the slot for the producer one lap ahead
+        slot.sequence.store(position + CAPACITY, std::memory_order_release);
+        position++;
+        written++;
+        tail_.store(position, std::memory_order_release);
+    }
+
+    // One flush per batch instead of one per line
+    if (wroteOut) std::fflush(stdout);
+    if (wroteErr) std::fflush(stderr);
+    return written;
+}
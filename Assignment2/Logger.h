@@ -0,0 +1,224 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+/**
+ * @enum LogLevel
+ * @brief Severity of a log message, from the most verbose to the most severe.
+ *
+ * @note ERR rather than ERROR because Windows headers define ERROR as a macro.
+ */
+enum class LogLevel {
+    DEBUG,   /**< Detailed tracing, such as every portrait constructed */
+    INFO,    /**< Normal progress messages */
+    WARNING, /**< Something unexpected that the program recovered from */
+    ERR,     /**< A failure */
+    OFF      /**< Used as a threshold only: nothing is logged */
+};
+
+/**
+ * @def LOG_MIN_LEVEL
+ * @brief Levels below this one (as an integer) are compiled out entirely.
+ */
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @def LOG_AT
+ * @brief Logs a printf-style message if its level is enabled.
+ *
+ * The arguments are not evaluated when the level is suppressed, so a disabled message costs one
+ * relaxed atomic load (or nothing, below LOG_MIN_LEVEL).
+ */
+#define LOG_AT(level, ...)                                                                  \
+    do {                                                                                    \
+        if (static_cast<int>(level) >= LOG_MIN_LEVEL && Logger::isEnabled(level)) {        \
+            Logger::instance().log(level, __VA_ARGS__);                                     \
+        }                                                                                   \
+    } while (0)
+
+#define LOG_DEBUG(...) LOG_AT(LogLevel::DEBUG, __VA_ARGS__)     /**< Logs at LogLevel::DEBUG */
+#define LOG_INFO(...) LOG_AT(LogLevel::INFO, __VA_ARGS__)       /**< Logs at LogLevel::INFO */
+#define LOG_WARNING(...) LOG_AT(LogLevel::WARNING, __VA_ARGS__) /**< Logs at LogLevel::WARNING */
+#define LOG_ERROR(...) LOG_AT(LogLevel::ERR, __VA_ARGS__)       /**< Logs at LogLevel::ERR */
+
+/**
+ * @class Logger
+ * @brief Asynchronous logger: callers format into a lock-free ring buffer, a background thread writes it out.
+ *
+ * Any thread may log. A message is formatted straight into a fixed-size slot of the ring, which
+ * is claimed with a single compare-and-swap, so logging never blocks on the terminal or on a
+ * lock. The drain thread, started with the first message, writes DEBUG and INFO messages to
+ * stdout and the others to stderr, in batches. When the ring is full new messages are dropped
+ * and counted rather than waited for.
+ *
+ * The threshold starts at INFO, or at the level named by the LOG_LEVEL environment variable
+ * (debug, info, warning, error or off).
+ *
+ * @note Messages longer than MESSAGE_SIZE - 1 characters are truncated.
+ *
+ * @author Harrison Grenier
+ */
+class Logger {
+public:
+    /**
+     * @brief Returns the process-wide logger, starting its drain thread on first use.
+     *
+     * @return The logger.
+     */
+    static Logger& instance();
+
+    /**
+     * @brief Checks whether messages of a level are currently written.
+     *
+     * @param level The level to check.
+     * @return True if the level is at or above the threshold.
+     */
+    static bool isEnabled(LogLevel level) {
+        return static_cast<int>(level) >= threshold_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Sets the lowest level that is written.
+     *
+     * @param level The new threshold; LogLevel::OFF silences everything.
+     */
+    static void setLevel(LogLevel level) { threshold_.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+    /**
+     * @brief Gets the lowest level that is written.
+     *
+     * @return The threshold.
+     */
+    static LogLevel getLevel() { return static_cast<LogLevel>(threshold_.load(std::memory_order_relaxed)); }
+
+    /**
+     * @brief Parses a level name as accepted in LOG_LEVEL.
+     *
+     * @param name The name, in any case; may be null.
+     * @param fallback Level returned when the name isn't recognized.
+     * @return The level.
+     */
+    static LogLevel parseLevel(const char* name, LogLevel fallback);
+
+    /**
+     * @brief Queues a printf-style message. Use the LOG_ macros, which skip suppressed levels.
+     *
+     * @param level Severity of the message.
+     * @param format printf format string.
+     */
+    void log(LogLevel level, const char* format, ...);
+
+    /**
+     * @brief Waits until every message queued so far has been written.
+     */
+    void flush();
+
+    /**
+     * @brief Gets the number of messages lost because the ring was full.
+     *
+     * @return The dropped message count.
+     */
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @var CAPACITY
+     * @brief Number of slots in the ring (a power of two).
+     */
+    static const size_t CAPACITY = 4096;
+
+    /**
+     * @var MESSAGE_SIZE
+     * @brief Bytes per slot, including the terminating null.
+     */
+    static const size_t MESSAGE_SIZE = 248;
+
+private:
+    /**
+     * @brief Allocates the ring and starts the drain thread.
+     */
+    Logger();
+
+    /**
+     * @brief Writes out the remaining messages and stops the drain thread.
+     */
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    /**
+     * @brief Body of the drain thread.
+     */
+    void drainLoop();
+
+    /**
+     * @brief Writes out every message currently ready.
+     *
+     * @return The number of messages written.
+     */
+    size_t drain();
+
+    /**
+     * @struct Slot
+     * @brief One message in the ring.
+     *
+     * The sequence number tells who owns the slot: it equals the write position when the slot is
+     * free for that position, and the position + 1 once the message in it is complete.
+     */
+    struct Slot {
+        std::atomic<size_t> sequence; /**< Ownership sequence number */
+        LogLevel level;               /**< Severity of the message */
+        char text[MESSAGE_SIZE];      /**< The formatted, null-terminated message */
+    };
+
+    /**
+     * @var threshold_
+     * @brief Lowest level written, as an integer.
+     */
+    static std::atomic<int> threshold_;
+
+    /**
+     * @var slots_
+     * @brief The ring.
+     */
+    std::unique_ptr<Slot[]> slots_;
+
+    /**
+     * @var head_
+     * @brief Next write position, advanced by the producers; kept on its own cache line.
+     */
+    alignas(64) std::atomic<size_t> head_;
+
+    /**
+     * @var tail_
+     * @brief Next read position, advanced only by the drain thread; kept on its own cache line.
+     */
+    alignas(64) std::atomic<size_t> tail_;
+
+    /**
+     * @var dropped_
+     * @brief Messages lost because the ring was full.
+     */
+    std::atomic<uint64_t> dropped_;
+
+    /**
+     * @var running_
+     * @brief Cleared to ask the drain thread to finish.
+     */
+    std::atomic<bool> running_;
+
+    /**
+     * @var drainThread_
+     * @brief Thread writing the messages out.
+     */
+    std::thread drainThread_;
+};
+
+#endif // LOGGER_H
@@ -0,0 +1,32 @@
+#ifndef NULLRENDERCONTEXT_H
+#define NULLRENDERCONTEXT_H
+
+#include "RenderContext.h"
+
+/**
+ * @class NullRenderContext
+ * @brief RenderContext backend that discards everything.
+ *
+ * Drawing into it runs the full scene traversal and geometry generation with no output, which
+ * makes it useful for headless runs and as a baseline when measuring the other backends.
+ *
+ * @see RenderContext
+ *
+ * @author Harrison Grenier
+ */
+class NullRenderContext : public RenderContext {
+public:
+    void setColor(float, float, float) override {}
+    void begin(PrimitiveType) override {}
+    void vertex(float, float) override {}
+    void end() override {}
+    void drawVertices(PrimitiveType, const float*, size_t) override {}
+    void pushMatrix() override {}
+    void popMatrix() override {}
+    void translate(float, float) override {}
+    void rotate(float) override {}
+    void scale(float, float) override {}
+    void multMatrix(const Affine2D&) override {}
+};
+
+#endif // NULLRENDERCONTEXT_H
@@ -2,16 +2,19 @@
 #define PORTRAIT_H
 
 #include "GraphicObject2D.h"  // Assuming this class provides basic 2D object properties
+#include <atomic>
 
 /**
  * @class portrait
  * @brief A class representing a portrait object that can be drawn with various features such as eyes, nose, mouth, etc.
  *
  * This class inherits from GraphicObject2D and provides functionality to draw a portrait with customizable features.
- * It includes helper methods to draw specific facial features like eyes, nose, and mouth. Additionally, the class
- * allows setting and getting the position, orientation, and scale of the portrait.
+ * The features themselves (eyes, nose, mouth and so on) are laid out once in the shared PortraitPrototype; an
+ * instance only adds its transform, size and an optional color tint. Additionally, the class allows setting and
+ * getting the position, orientation, and scale of the portrait.
  *
  * @see GraphicObject2D
+ * @see PortraitPrototype
  *
  * @note This class includes static data members to track portrait instances.
  *
@@ -33,86 +36,100 @@ private:
 
     /**
      * @var count_
-     * @brief Static variable to keep track of the total number of portrait instances.
+     * @brief Next unused portrait index; atomic so portraits can be built on several threads.
      */
-    static unsigned int count_;
+    static std::atomic<unsigned int> count_;
 
-public:
     /**
-     * @brief Constructs a portrait with specified position, size, and orientation.
+     * @var lodScale_
+     * @brief Pixels per local unit the tessellation level was last chosen for (0 = not yet chosen).
      *
-     * @param cx X-coordinate of the portrait's position.
-     * @param cy Y-coordinate of the portrait's position.
-     * @param size Size of the portrait.
-     * @param orientation Orientation (rotation) of the portrait in degrees. Default is 0.0f.
+     * Kept between frames so the level only changes once the on-screen size has changed noticeably.
      */
-    portrait(float cx, float cy, float size, float orientation = 0.0f);
+    mutable float lodScale_;
 
     /**
-     * @brief Deleted default constructor to prevent instantiation without parameters.
+     * @var tintR_
+     * @brief Red factor applied to every feature color (1 = unchanged).
      */
-    portrait() = delete;
+    float tintR_;
 
     /**
-     * @brief Default destructor for the portrait class.
+     * @var tintG_
+     * @brief Green factor applied to every feature color (1 = unchanged).
      */
-    ~portrait() = default;
+    float tintG_;
 
     /**
-     * @brief Overridden draw method to render the portrait.
-     *
-     * This method calls helper functions to draw different parts of the portrait.
+     * @var tintB_
+     * @brief Blue factor applied to every feature color (1 = unchanged).
      */
-    void draw() const override;
+    float tintB_;
 
+public:
     /**
-     * @brief Helper method to draw an ellipse (used for facial features).
+     * @brief Constructs a portrait with specified position, size, and orientation.
      *
-     * @param xc X-coordinate of the ellipse center.
-     * @param yc Y-coordinate of the ellipse center.
-     * @param Semi_major Semi-major axis of the ellipse.
-     * @param Semi_minor Semi-minor axis of the ellipse.
-     * @param segments Number of segments for drawing the ellipse.
-     * @param r Red color component.
-     * @param g Green color component.
-     * @param b Blue color component.
+     * @param cx X-coordinate of the portrait's position.
+     * @param cy Y-coordinate of the portrait's position.
+     * @param size Size of the portrait.
+     * @param orientation Orientation (rotation) of the portrait in degrees. Default is 0.0f.
      */
-    void drawEllipse(float xc, float yc, float Semi_major, float Semi_minor, int segments, float r, float g, float b) const;
+    portrait(float cx, float cy, float size, float orientation = 0.0f);
 
     /**
-     * @brief Helper method to draw the eyes of the portrait.
+     * @brief Constructs a portrait with an index taken from a range reserved with reserveIds().
+     *
+     * @param cx X-coordinate of the portrait's position.
+     * @param cy Y-coordinate of the portrait's position.
+     * @param size Size of the portrait.
+     * @param orientation Orientation (rotation) of the portrait in degrees.
+     * @param id The portrait's index.
      */
-    void drawEyes() const;
+    portrait(float cx, float cy, float size, float orientation, unsigned int id);
 
     /**
-     * @brief Helper method to draw the nose of the portrait.
+     * @brief Reserves a contiguous range of portrait indices.
+     *
+     * @param count Number of indices to reserve.
+     * @return The first index of the range.
      */
-    void drawNose() const;
+    static unsigned int reserveIds(unsigned int count) { return count_.fetch_add(count, std::memory_order_relaxed); }
 
     /**
-     * @brief Helper method to draw the mouth of the portrait.
+     * @brief Deleted default constructor to prevent instantiation without parameters.
      */
-    void drawMouth() const;
+    portrait() = delete;
 
     /**
-     * @brief Helper method to draw the ears of the portrait.
+     * @brief Default destructor for the portrait class.
      */
-    void drawEars() const;
+    ~portrait() = default;
 
     /**
-     * @brief Helper method to draw the eyebrows of the portrait.
+     * @brief Overridden draw method to render the portrait.
+     *
+     * This method draws the prototype's features, scaled to the portrait's size.
+     *
+     * @param context The render context to draw into.
      */
-    void drawEyebrows() const;
+    void draw(RenderContext& context) const override;
 
     /**
-     * @brief Helper method to draw the pupils of the portrait.
+     * @brief Gets a box enclosing the face, ears and hat, before the portrait's transformation.
+     *
+     * @return The portrait's local bounds.
      */
-    void drawPupils() const;
+    BoundingBox2D getLocalBounds() const override;
 
     /**
-     * @brief Helper method to draw a hat on the portrait.
+     * @brief Checks whether a point lies on the face, an ear or the hat.
+     *
+     * @param x X-coordinate of the point, in the same space as getLocalBounds().
+     * @param y Y-coordinate of the point, in the same space as getLocalBounds().
+     * @return True if the point is covered by the portrait.
      */
-    void drawHat() const;
+    bool hitTest(float x, float y) const;
 
     /**
      * @brief Sets the position of the portrait.
@@ -163,6 +180,50 @@ public:
      * @return The current scale factor of the portrait.
      */
     float getScale() const;
+
+    /**
+     * @brief Gets the size the portrait's features are laid out for.
+     *
+     * @return The size of the portrait.
+     */
+    float getSize() const { return size_; }
+
+    /**
+     * @brief Gets the portrait's unique index.
+     *
+     * @return The index.
+     */
+    unsigned int getId() const { return idx_; }
+
+    /**
+     * @brief Sets the factors the feature colors are multiplied by.
+     *
+     * @param r Red factor.
+     * @param g Green factor.
+     * @param b Blue factor.
+     */
+    void setTint(float r, float g, float b);
+
+    /**
+     * @brief Gets the red tint factor.
+     *
+     * @return The red factor (1 when untinted).
+     */
+    float getTintR() const { return tintR_; }
+
+    /**
+     * @brief Gets the green tint factor.
+     *
+     * @return The green factor (1 when untinted).
+     */
+    float getTintG() const { return tintG_; }
+
+    /**
+     * @brief Gets the blue tint factor.
+     *
+     * @return The blue factor (1 when untinted).
+     */
+    float getTintB() const { return tintB_; }
 };
 
 #endif /* PORTRAIT_H */
@@ -0,0 +1,41 @@
+#include "PortraitMesh.h"
+
+const std::vector<MeshVertex>& PortraitMesh::get() {
+    // Function-local static: built on first use, thread-safe initialization
+    static const std::vector<MeshVertex> mesh = [] {
+        std::vector<MeshVertex> m;
+        const PortraitPrototype& prototype = PortraitPrototype::get();
+        const std::vector<PortraitFeature>& features = prototype.getFeatures();
+        for (size_t i = 0; i < features.size(); i++) {
+            addFeature(m, features[i], prototype.getOutline(i, features[i].segments));
+        }
+        return m;
+    }();
+    return mesh;
+}
+
+void PortraitMesh::addFeature(std::vector<MeshVertex>& mesh, const PortraitFeature& feature,
+                              const std::vector<OutlinePoint>& outline) {
+    float r = feature.r, g = feature.g, b = feature.b;
+    float hat = feature.hatBody ? 1.0f : 0.0f;
+    size_t count = outline.size();
+
+    if (feature.shape == FeatureShape::RECTANGLE) {
+        // Two triangles sharing the first corner
+        for (size_t i = 1; i + 1 < count; i++) {
+            mesh.push_back({ outline[0].x, outline[0].y, r, g, b, hat });
+            mesh.push_back({ outline[i].x, outline[i].y, r, g, b, hat });
+            mesh.push_back({ outline[i + 1].x, outline[i + 1].y, r, g, b, hat });
+        }
+        return;
+    }
+
+    // A fan around the center, closing back on the first outline point
+    for (size_t i = 0; i < count; i++) {
+        const OutlinePoint& p0 = outline[i];
+        const OutlinePoint& p1 = outline[(i + 1) % count];
+        mesh.push_back({ feature.centerX, feature.centerY, r, g, b, hat });
+        mesh.push_back({ p0.x, p0.y, r, g, b, hat });
+        mesh.push_back({ p1.x, p1.y, r, g, b, hat });
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef PORTRAITMESH_H
+#define PORTRAITMESH_H
+
+#include "PortraitPrototype.h"
+#include <vector>
+
+/**
+ * @struct MeshVertex
+ * @brief A colored 2D vertex of a triangle mesh, marked if it belongs to the hat body.
+ */
+struct MeshVertex {
+    float x; /**< X-coordinate */
+    float y; /**< Y-coordinate */
+    float r; /**< Red color component */
+    float g; /**< Green color component */
+    float b; /**< Blue color component */
+    float hat; /**< 1 for vertices of the hat body, which moves with the portrait's size, otherwise 0 */
+};
+
+/**
+ * @class PortraitMesh
+ * @brief Triangle-list version of a portrait built in unit space (size 1).
+ *
+ * The mesh contains the PortraitPrototype features portrait::draw uses, in the same back-to-front
+ * order, with every ellipse fanned into triangles and every rectangle split in two. It is built once and shared, so a renderer can upload it a single time
+ * and place each portrait with a translation, rotation and scale.
+ *
+ * @note The hat body is placed as for a portrait of size 1 and its vertices are marked, so a
+ *       renderer can shift them by PortraitPrototype::hatOffset() as portrait::draw does.
+ *
+ * @see portrait
+ * @see PortraitPrototype
+ *
+ * @author Harrison Grenier
+ */
+class PortraitMesh {
+public:
+    /**
+     * @brief Returns the shared unit-space portrait mesh, built on first use.
+     *
+     * @return Triangle list (three vertices per triangle) of the portrait.
+     */
+    static const std::vector<MeshVertex>& get();
+
+    /**
+     * @brief Deleted constructor, the class only exposes static lookups.
+     */
+    PortraitMesh() = delete;
+
+private:
+    /**
+     * @brief Appends one prototype feature to the mesh at full detail.
+     *
+     * Ellipses are fanned from their center, rectangles split into two triangles.
+     *
+     * @param mesh Mesh to append to.
+     * @param feature The feature.
+     * @param outline The feature's outline at full detail.
+     */
+    static void addFeature(std::vector<MeshVertex>& mesh, const PortraitFeature& feature,
+                           const std::vector<OutlinePoint>& outline);
+};
+
+#endif // PORTRAITMESH_H
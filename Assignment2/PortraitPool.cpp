@@ -0,0 +1,280 @@
+#include "PortraitPool.h"
+#include "ComplexGraphicObject2D.h"
+#include "Portrait.h"
+#include "PortraitPrototype.h"
+#include "LevelOfDetail.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#define PORTRAITPOOL_AVX_KERNELS
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PORTRAITPOOL_SSE_KERNELS
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang need AVX enabled per function so the rest of the build keeps its baseline ISA
+#if defined(__GNUC__)
+#define PORTRAITPOOL_TARGET_AVX __attribute__((target("avx")))
+#else
+#define PORTRAITPOOL_TARGET_AVX
+#endif
+
+namespace {
+
+// The arrays a rotation touches: placements are rewritten from the unrotated offsets every time
+struct RotateRows {
+    float* x;
+    float* y;
+    float* orientation;
+    const float* offsetX;
+    const float* offsetY;
+    const float* baseOrientation;
+    const float* wheelX;
+    const float* wheelY;
+    const float* spin;
+};
+
+// Scalar kernels, also used for the elements left over by the vector ones
+void rotateScalar(const RotateRows& rows, size_t begin, size_t end, float cs, float sn, float angle) {
+    for (size_t i = begin; i < end; i++) {
+        float dx = rows.offsetX[i];
+        float dy = rows.offsetY[i];
+        rows.x[i] = rows.wheelX[i] + (dx * cs - dy * sn);
+        rows.y[i] = rows.wheelY[i] + (dx * sn + dy * cs);
+        rows.orientation[i] = rows.baseOrientation[i] + angle * rows.spin[i];
+    }
+}
+
+void scaleScalar(float* scale, size_t begin, size_t end, float factor) {
+    for (size_t i = begin; i < end; i++) {
+        scale[i] *= factor;
+    }
+}
+
+#ifdef PORTRAITPOOL_SSE_KERNELS
+// Four portraits per step from begin on; returns the index of the first element left over
+size_t rotateSSE(const RotateRows& rows, size_t begin, size_t count, float cs, float sn, float angle) {
+    const __m128 vcs = _mm_set1_ps(cs), vsn = _mm_set1_ps(sn), vangle = _mm_set1_ps(angle);
+    size_t i = begin;
+    for (; i + 4 <= count; i += 4) {
+        __m128 wx = _mm_loadu_ps(rows.wheelX + i), wy = _mm_loadu_ps(rows.wheelY + i);
+        __m128 dx = _mm_loadu_ps(rows.offsetX + i);
+        __m128 dy = _mm_loadu_ps(rows.offsetY + i);
+        _mm_storeu_ps(rows.x + i, _mm_add_ps(wx, _mm_sub_ps(_mm_mul_ps(dx, vcs), _mm_mul_ps(dy, vsn))));
+        _mm_storeu_ps(rows.y + i, _mm_add_ps(wy, _mm_add_ps(_mm_mul_ps(dx, vsn), _mm_mul_ps(dy, vcs))));
+        __m128 turn = _mm_mul_ps(vangle, _mm_loadu_ps(rows.spin + i));
+        _mm_storeu_ps(rows.orientation + i, _mm_add_ps(_mm_loadu_ps(rows.baseOrientation + i), turn));
+    }
+    return i;
+}
+
+size_t scaleSSE(float* scale, size_t begin, size_t count, float factor) {
+    const __m128 vfactor = _mm_set1_ps(factor);
+    size_t i = begin;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(scale + i, _mm_mul_ps(_mm_loadu_ps(scale + i), vfactor));
+    }
+    return i;
+}
+#endif
+
+#ifdef PORTRAITPOOL_AVX_KERNELS
+// Eight portraits per step, same arithmetic as the scalar kernel (no FMA) so results match exactly
+PORTRAITPOOL_TARGET_AVX size_t rotateAVX(const RotateRows& rows, size_t begin, size_t count, float cs, float sn,
+                                          float angle) {
+    const __m256 vcs = _mm256_set1_ps(cs), vsn = _mm256_set1_ps(sn), vangle = _mm256_set1_ps(angle);
+    size_t i = begin;
+    for (; i + 8 <= count; i += 8) {
+        __m256 wx = _mm256_loadu_ps(rows.wheelX + i), wy = _mm256_loadu_ps(rows.wheelY + i);
+        __m256 dx = _mm256_loadu_ps(rows.offsetX + i);
+        __m256 dy = _mm256_loadu_ps(rows.offsetY + i);
+        _mm256_storeu_ps(rows.x + i, _mm256_add_ps(wx, _mm256_sub_ps(_mm256_mul_ps(dx, vcs), _mm256_mul_ps(dy, vsn))));
+        _mm256_storeu_ps(rows.y + i, _mm256_add_ps(wy, _mm256_add_ps(_mm256_mul_ps(dx, vsn), _mm256_mul_ps(dy, vcs))));
+        __m256 turn = _mm256_mul_ps(vangle, _mm256_loadu_ps(rows.spin + i));
+        _mm256_storeu_ps(rows.orientation + i, _mm256_add_ps(_mm256_loadu_ps(rows.baseOrientation + i), turn));
+    }
+    _mm256_zeroupper();
+    return i;
+}
+
+PORTRAITPOOL_TARGET_AVX size_t scaleAVX(float* scale, size_t begin, size_t count, float factor) {
+    const __m256 vfactor = _mm256_set1_ps(factor);
+    size_t i = begin;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(scale + i, _mm256_mul_ps(_mm256_loadu_ps(scale + i), vfactor));
+    }
+    _mm256_zeroupper();
+    return i;
+}
+
+#endif
+
+// AVX needs both the instructions and the OS saving the YMM registers; checked once
+bool cpuHasAVX() {
+#ifdef PORTRAITPOOL_AVX_KERNELS
+    static const bool supported = [] {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        bool osSaves = (info[2] & (1 << 27)) != 0;
+        bool hasAVX = (info[2] & (1 << 28)) != 0;
+        return osSaves && hasAVX && (_xgetbv(0) & 0x6) == 0x6;
+#else
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx") != 0;
+#endif
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// Bounds of the prototype in unit space, with the hat body shifted as portrait places it
+BoundingBox2D unitBounds(float hatOffset) {
+    return { -1.2f, -1.0f, 1.2f, 2.3f + hatOffset };
+}
+
+} // namespace
+
+void PortraitPool::addWheel(const ComplexGraphicObject2D& wheel) {
+    for (size_t i = 0; i < wheel.getPartCount(); i++) {
+        const portrait* face = dynamic_cast<const portrait*>(wheel.getPart(i));
+        if (!face) {
+            continue;
+        }
+
+        // Same decomposition as the instanced renderer: the matrix holds the wheel's and the
+        // portrait's scale, the size is applied again when the portrait is drawn
+        Affine2D world = wheel.getPartSpace(i) * face->getTransform();
+        float scale = std::sqrt(world.a * world.a + world.b * world.b);
+        float orientation = std::atan2(world.b, world.a) * (180.0f / 3.1415926f);
+        add(world.tx, world.ty, orientation, scale, face->getSize(), wheel.getPositionX(), wheel.getPositionY(),
+            wheel.getPartInheritsOrientation(i));
+    }
+}
+
+void PortraitPool::add(float x, float y, float orientation, float scale, float size, float wheelX, float wheelY,
+                       bool turnsWithWheel) {
+    x_.push_back(x);
+    y_.push_back(y);
+    orientation_.push_back(orientation);
+
+    // Undo the rotation the wheels already have, so the placement can be rebuilt from the offset at any angle
+    float radian = -wheelAngle_ * (3.1415926f / 180.0f);
+    float cs = std::cos(radian), sn = std::sin(radian);
+    float dx = x - wheelX, dy = y - wheelY;
+    offsetX_.push_back(dx * cs - dy * sn);
+    offsetY_.push_back(dx * sn + dy * cs);
+    baseOrientation_.push_back(turnsWithWheel ? orientation - wheelAngle_ : orientation);
+    scale_.push_back(scale);
+    size_.push_back(size);
+    wheelX_.push_back(wheelX);
+    wheelY_.push_back(wheelY);
+    spin_.push_back(turnsWithWheel ? 1.0f : 0.0f);
+}
+
+void PortraitPool::reserve(size_t count) {
+    for (std::vector<float>* column : { &x_, &y_, &orientation_, &offsetX_, &offsetY_, &baseOrientation_, &scale_, &size_,
+                                         &wheelX_, &wheelY_, &spin_ }) {
+        column->reserve(count);
+    }
+}
+
+void PortraitPool::clear() {
+    for (std::vector<float>* column : { &x_, &y_, &orientation_, &offsetX_, &offsetY_, &baseOrientation_, &scale_, &size_,
+                                         &wheelX_, &wheelY_, &spin_ }) {
+        column->clear();
+    }
+    wheelAngle_ = 0.0f;
+}
+
+// Every placement is computed from its offset at the total angle, so rounding doesn't build up over the ticks
+void PortraitPool::rotateWheels(float angle) {
+    wheelAngle_ = std::fmod(wheelAngle_ + angle, 360.0f);
+    angle = wheelAngle_;
+    float radian = angle * (3.1415926f / 180.0f);
+    float cs = std::cos(radian), sn = std::sin(radian);
+    RotateRows rows = { x_.data(), y_.data(), orientation_.data(), offsetX_.data(), offsetY_.data(), baseOrientation_.data(),
+                        wheelX_.data(), wheelY_.data(), spin_.data() };
+    size_t count = size();
+    size_t done = 0;
+#ifdef PORTRAITPOOL_AVX_KERNELS
+    if (cpuHasAVX()) {
+        done = rotateAVX(rows, done, count, cs, sn, angle);
+    }
+#endif
+#ifdef PORTRAITPOOL_SSE_KERNELS
+    done = rotateSSE(rows, done, count, cs, sn, angle);
+#endif
+    rotateScalar(rows, done, count, cs, sn, angle);
+}
+
+void PortraitPool::scaleHeads(float factor) {
+    size_t count = size();
+    size_t done = 0;
+#ifdef PORTRAITPOOL_AVX_KERNELS
+    if (cpuHasAVX()) {
+        done = scaleAVX(scale_.data(), done, count, factor);
+    }
+#endif
+#ifdef PORTRAITPOOL_SSE_KERNELS
+    done = scaleSSE(scale_.data(), done, count, factor);
+#endif
+    scaleScalar(scale_.data(), done, count, factor);
+}
+
+// Same outlines and level of detail as portrait::draw, each feature submitted in one call
+void PortraitPool::draw(RenderContext& context) const {
+    const PortraitPrototype& prototype = PortraitPrototype::get();
+    const std::vector<PortraitFeature>& features = prototype.getFeatures();
+    float pixelsPerUnit = context.getPixelsPerUnit();
+    std::vector<float> points;
+
+    for (size_t i = 0; i < size(); i++) {
+        float unitScale = scale_[i] * size_[i];
+        float hatOffset = PortraitPrototype::hatOffset(size_[i]);
+        Affine2D placement = Affine2D::fromTransform(x_[i], y_[i], orientation_[i], unitScale);
+        if (!context.isVisible(unitBounds(hatOffset).transformed(placement))) {
+            continue;
+        }
+
+        context.pushMatrix();
+        context.multMatrix(placement);
+        for (size_t f = 0; f < features.size(); f++) {
+            const PortraitFeature& feature = features[f];
+            int segments = feature.segments;
+            if (feature.shape == FeatureShape::ELLIPSE) {
+                segments = LevelOfDetail::ellipseSegments(std::max(feature.halfWidth, feature.halfHeight) * pixelsPerUnit * unitScale, segments);
+            }
+            const std::vector<OutlinePoint>& outline = prototype.getOutline(f, segments);
+            float offsetY = feature.hatBody ? hatOffset : 0.0f;
+            points.clear();
+            for (const OutlinePoint& p : outline) {
+                points.push_back(p.x);
+                points.push_back(p.y + offsetY);
+            }
+
+            context.setColor(feature.r, feature.g, feature.b);
+            context.drawVertices(feature.shape == FeatureShape::ELLIPSE ? PrimitiveType::POLYGON : PrimitiveType::QUADS,
+                                 points.data(), outline.size());
+        }
+        context.popMatrix();
+    }
+}
+
+const char* PortraitPool::getKernelName() {
+    if (cpuHasAVX()) {
+        return "avx";
+    }
+#ifdef PORTRAITPOOL_SSE_KERNELS
+    return "sse";
+#else
+    return "scalar";
+#endif
+}
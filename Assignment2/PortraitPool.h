@@ -0,0 +1,219 @@
+#ifndef PORTRAITPOOL_H
+#define PORTRAITPOOL_H
+
+#include "RenderContext.h"
+#include <cstddef>
+#include <vector>
+
+class ComplexGraphicObject2D;
+
+/**
+ * @class PortraitPool
+ * @brief Data-oriented store of portrait placements, kept in parallel arrays for bulk updates.
+ *
+ * Each portrait is a row across the arrays: world position, orientation, scale and size, plus the
+ * center of the wheel it belongs to and whether it turns with that wheel. Bulk operations walk the
+ * arrays with SSE or AVX kernels (chosen at run time from what the CPU supports) and a scalar loop
+ * for the remaining elements, so animating a million portraits touches only the floats it changes
+ * and never a vtable.
+ *
+ * Rotations don't accumulate: every portrait keeps its offset from its wheel's center at the angle
+ * it was added with, and each rotation places it from that offset at the wheels' total angle, so
+ * the portraits stay on their wheels however long they turn.
+ *
+ * The pool is a snapshot: it is filled from wheels with addWheel() and then animated and drawn on
+ * its own, without writing back to the original objects. It is only used by the bench_wheels
+ * benchmark (--mode pool); the interactive program still animates and draws the wheel objects.
+ *
+ * @see PortraitWheel
+ * @see PortraitPrototype
+ *
+ * @author Harrison Grenier
+ */
+class PortraitPool {
+public:
+    /**
+     * @brief Appends every portrait of a wheel, in world space.
+     *
+     * Parts that aren't portraits are ignored. Portraits that don't inherit the wheel's orientation
+     * keep theirs when the pool rotates the wheels.
+     *
+     * @param wheel The wheel to copy the portraits from.
+     */
+    void addWheel(const ComplexGraphicObject2D& wheel);
+
+    /**
+     * @brief Appends one portrait.
+     *
+     * @param x World X-coordinate of the portrait.
+     * @param y World Y-coordinate of the portrait.
+     * @param orientation Orientation in degrees.
+     * @param scale Scale applied on top of the size, as for a portrait's transform.
+     * @param size Size of the portrait.
+     * @param wheelX World X-coordinate of the center the portrait rotates about.
+     * @param wheelY World Y-coordinate of the center the portrait rotates about.
+     * @param turnsWithWheel Whether rotating the wheel also turns the portrait.
+     */
+    void add(float x, float y, float orientation, float scale, float size, float wheelX, float wheelY,
+             bool turnsWithWheel);
+
+    /**
+     * @brief Reserves room for portraits so filling the pool doesn't reallocate.
+     *
+     * @param count Total number of portraits the pool will hold.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Removes every portrait.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of portraits in the pool.
+     *
+     * @return The portrait count.
+     */
+    size_t size() const { return x_.size(); }
+
+    /**
+     * @brief Rotates every wheel about its center: moves its portraits and turns the ones that follow it.
+     *
+     * @param angle Rotation in degrees, added to the total angle of the wheels.
+     */
+    void rotateWheels(float angle);
+
+    /**
+     * @brief Multiplies the scale of every portrait.
+     *
+     * @param factor Scale factor.
+     */
+    void scaleHeads(float factor);
+
+    /**
+     * @brief Draws every portrait from the PortraitPrototype outlines, as portrait::draw does.
+     *
+     * Ellipses get the same level of detail as for the wheel objects, and each feature is submitted
+     * with one drawVertices() call. Portraits outside the context's view bounds are skipped.
+     *
+     * @param context The render context to draw into.
+     */
+    void draw(RenderContext& context) const;
+
+    /**
+     * @brief Gets the name of the kernel set the bulk operations run with on this CPU.
+     *
+     * @return "avx", "sse" or "scalar".
+     */
+    static const char* getKernelName();
+
+    /**
+     * @brief Gets the world X-coordinates of all portraits.
+     *
+     * @return Array of size() values.
+     */
+    const float* getX() const { return x_.data(); }
+
+    /**
+     * @brief Gets the world Y-coordinates of all portraits.
+     *
+     * @return Array of size() values.
+     */
+    const float* getY() const { return y_.data(); }
+
+    /**
+     * @brief Gets the orientations of all portraits, in degrees.
+     *
+     * @return Array of size() values.
+     */
+    const float* getOrientation() const { return orientation_.data(); }
+
+    /**
+     * @brief Gets the scales of all portraits, applied on top of their sizes.
+     *
+     * @return Array of size() values.
+     */
+    const float* getScale() const { return scale_.data(); }
+
+    /**
+     * @brief Gets the sizes of all portraits.
+     *
+     * @return Array of size() values.
+     */
+    const float* getSize() const { return size_.data(); }
+
+private:
+    /**
+     * @var x_
+     * @brief World X-coordinate of every portrait.
+     */
+    std::vector<float> x_;
+
+    /**
+     * @var y_
+     * @brief World Y-coordinate of every portrait.
+     */
+    std::vector<float> y_;
+
+    /**
+     * @var orientation_
+     * @brief Orientation of every portrait in degrees.
+     */
+    std::vector<float> orientation_;
+
+    /**
+     * @var offsetX_
+     * @brief X offset of every portrait from its wheel's center, before any rotation of the pool.
+     */
+    std::vector<float> offsetX_;
+
+    /**
+     * @var offsetY_
+     * @brief Y offset of every portrait from its wheel's center, before any rotation of the pool.
+     */
+    std::vector<float> offsetY_;
+
+    /**
+     * @var baseOrientation_
+     * @brief Orientation of every portrait before any rotation of the pool, in degrees.
+     */
+    std::vector<float> baseOrientation_;
+
+    /**
+     * @var scale_
+     * @brief Scale of every portrait, applied on top of its size.
+     */
+    std::vector<float> scale_;
+
+    /**
+     * @var size_
+     * @brief Size of every portrait.
+     */
+    std::vector<float> size_;
+
+    /**
+     * @var wheelX_
+     * @brief World X-coordinate of the center each portrait rotates about.
+     */
+    std::vector<float> wheelX_;
+
+    /**
+     * @var wheelY_
+     * @brief World Y-coordinate of the center each portrait rotates about.
+     */
+    std::vector<float> wheelY_;
+
+    /**
+     * @var spin_
+     * @brief 1 for portraits that turn with their wheel, 0 for ones that stay upright.
+     */
+    std::vector<float> spin_;
+
+    /**
+     * @var wheelAngle_
+     * @brief Total rotation of the wheels since the pool was filled, in degrees within (-360, 360).
+     */
+    float wheelAngle_ = 0.0f;
+};
+
+#endif // PORTRAITPOOL_H
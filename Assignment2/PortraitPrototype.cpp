@@ -0,0 +1,90 @@
+#include "PortraitPrototype.h"
+#include "UnitCircle.h"
+#include "LevelOfDetail.h"
+
+const PortraitPrototype& PortraitPrototype::get() {
+    // Function-local static: built on first use, thread-safe initialization
+    static const PortraitPrototype prototype;
+    return prototype;
+}
+
+PortraitPrototype::PortraitPrototype() {
+    addEllipse(0, 0, 1.0f, 1.0f, 200, 0.878f, 0.694f, 0.517f);  // portrait
+
+    // Eyes: 20% wide, 15% high, 30% from the center and 25% above it
+    addEllipse(-0.3f, 0.25f, 0.2f, 0.15f, 100, 1.0f, 1.0f, 1.0f);
+    addEllipse(0.3f, 0.25f, 0.2f, 0.15f, 100, 1.0f, 1.0f, 1.0f);
+
+    // Pupils: small circles in the middle of the eyes
+    addEllipse(-0.3f, 0.25f, 0.07f, 0.07f, 100, 0.0f, 0.0f, 0.0f);
+    addEllipse(0.3f, 0.25f, 0.07f, 0.07f, 100, 0.0f, 0.0f, 0.0f);
+
+    // Nose: 10% wide, 30% high, hanging below the center
+    addEllipse(0, -0.15f, 0.1f, 0.3f, 100, 0.8f, 0.5f, 0.4f);
+
+    // Mouth: 50% wide, 10% high, below the nose
+    addEllipse(0, -0.6f, 0.5f, 0.1f, 100, 1.0f, 0.0f, 0.0f);
+
+    // Ears: just outside the face, level with the eyes
+    addEllipse(-1.0f, 0.25f, 0.15f, 0.3f, 100, 0.878f, 0.694f, 0.517f);
+    addEllipse(1.0f, 0.25f, 0.15f, 0.3f, 100, 0.878f, 0.694f, 0.517f);
+
+    // Eyebrows: thin dark rectangles above the eyes
+    addRectangle(-0.45f, 0.35f, -0.15f, 0.4f, 0.3f, 0.2f, 0.1f);
+    addRectangle(0.15f, 0.35f, 0.45f, 0.4f, 0.3f, 0.2f, 0.1f);
+
+    // Hat: a wide flat brim just above the face, then a tall body on top of it
+    addEllipse(0.0f, 0.7f, 1.2f, 0.05f, 100, 0.3f, 0.2f, 0.1f);
+    addRectangle(-0.65f, 0.7f, 0.65f, 2.3f, 0.3f, 0.2f, 0.1f, true);
+}
+
+const std::vector<OutlinePoint>& PortraitPrototype::getOutline(size_t feature, int segments) const {
+    const std::vector<Level>& levels = levels_[feature];
+    for (const Level& level : levels) {
+        if (level.segments >= segments) {
+            return level.outline;
+        }
+    }
+    return levels.back().outline;
+}
+
+bool PortraitPrototype::hitTest(float x, float y, float hatOffset) const {
+    // The inner features lie on the face, so any feature covering the point means the portrait does
+    for (const PortraitFeature& f : features_) {
+        float fy = f.hatBody ? f.centerY + hatOffset : f.centerY;
+        float dx = (x - f.centerX) / f.halfWidth;
+        float dy = (y - fy) / f.halfHeight;
+        bool inside = (f.shape == FeatureShape::ELLIPSE) ? dx * dx + dy * dy <= 1.0f
+                                                         : dx >= -1.0f && dx <= 1.0f && dy >= -1.0f && dy <= 1.0f;
+        if (inside) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PortraitPrototype::addEllipse(float xc, float yc, float Semi_major, float Semi_minor, int segments,
+                                   float r, float g, float b) {
+    features_.push_back({ FeatureShape::ELLIPSE, xc, yc, Semi_major, Semi_minor, segments, r, g, b, false });
+
+    // One outline per segment count LevelOfDetail can pick for this ellipse, ending at full detail
+    std::vector<Level> levels;
+    for (int level : LevelOfDetail::LEVELS) {
+        int count = level < segments ? level : segments;
+        if (!levels.empty() && levels.back().segments == count) {
+            break;
+        }
+        Level outline{ count, {} };
+        for (const UnitCirclePoint& p : UnitCircle::get(count)) {
+            outline.outline.push_back({ Semi_major * p.x + xc, Semi_minor * p.y + yc });  // x = a * cos(theta), y = b * sin(theta)
+        }
+        levels.push_back(std::move(outline));
+    }
+    levels_.push_back(std::move(levels));
+}
+
+void PortraitPrototype::addRectangle(float x0, float y0, float x1, float y1, float r, float g, float b, bool hatBody) {
+    features_.push_back({ FeatureShape::RECTANGLE, (x0 + x1) / 2, (y0 + y1) / 2, (x1 - x0) / 2, (y1 - y0) / 2, 4,
+                          r, g, b, hatBody });
+    levels_.push_back({ { 4, { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } } } });
+}
@@ -0,0 +1,163 @@
+#ifndef PORTRAITPROTOTYPE_H
+#define PORTRAITPROTOTYPE_H
+
+#include "BoundingBox2D.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @enum FeatureShape
+ * @brief The two kinds of shape a portrait is built from.
+ */
+enum class FeatureShape {
+    ELLIPSE,  /**< A filled ellipse around (centerX, centerY) with semi-axes halfWidth and halfHeight */
+    RECTANGLE /**< An axis-aligned filled rectangle around (centerX, centerY) */
+};
+
+/**
+ * @struct OutlinePoint
+ * @brief A point of a feature outline, in unit space.
+ */
+struct OutlinePoint {
+    float x; /**< X-coordinate */
+    float y; /**< Y-coordinate */
+};
+
+/**
+ * @struct PortraitFeature
+ * @brief One face part of the prototype: its shape, placement and color at size 1.
+ */
+struct PortraitFeature {
+    FeatureShape shape; /**< Ellipse or rectangle */
+    float centerX;      /**< X-coordinate of the center */
+    float centerY;      /**< Y-coordinate of the center */
+    float halfWidth;    /**< Semi-axis along X, or half the rectangle width */
+    float halfHeight;   /**< Semi-axis along Y, or half the rectangle height */
+    int segments;       /**< Segments of an ellipse at full detail (4 for a rectangle) */
+    float r;            /**< Red color component */
+    float g;            /**< Green color component */
+    float b;            /**< Blue color component */
+    bool hatBody;       /**< True for the hat body, which portrait moves by a size-dependent offset */
+};
+
+/**
+ * @class PortraitPrototype
+ * @brief The single, immutable layout of a portrait shared by every instance.
+ *
+ * All portraits have the same proportions, so their face, eyes, pupils, nose, mouth, ears,
+ * eyebrows and hat are described once here in unit space (size 1), back to front. Every ellipse
+ * is also tessellated up front at each level of detail it can be drawn with, so drawing a
+ * portrait only transforms and emits ready-made outlines; instances keep just their transform
+ * and tint.
+ *
+ * @note portrait places its hat body with a fixed 0.05 offset rather than one proportional to its
+ *       size; hatOffset() gives the matching shift of the hatBody feature for a given size.
+ *
+ * @see portrait
+ * @see PortraitMesh
+ *
+ * @author Harrison Grenier
+ */
+class PortraitPrototype {
+public:
+    /**
+     * @brief Returns the shared prototype, built on first use.
+     *
+     * @return The prototype.
+     */
+    static const PortraitPrototype& get();
+
+    /**
+     * @brief Gets the features, in drawing order.
+     *
+     * @return The features.
+     */
+    const std::vector<PortraitFeature>& getFeatures() const { return features_; }
+
+    /**
+     * @brief Gets the outline of a feature tessellated with a given number of segments.
+     *
+     * @param feature Index of the feature, as in getFeatures().
+     * @param segments A segment count returned by LevelOfDetail::ellipseSegments() for the feature
+     *                 (ignored for rectangles).
+     * @return The outline, counter-clockwise.
+     */
+    const std::vector<OutlinePoint>& getOutline(size_t feature, int segments) const;
+
+    /**
+     * @brief Checks whether a point lies on the face, an ear or the hat.
+     *
+     * Eyes, pupils, nose, mouth and eyebrows lie inside the face and don't need testing.
+     *
+     * @param x X-coordinate of the point, in unit space.
+     * @param y Y-coordinate of the point, in unit space.
+     * @param hatOffset Vertical shift of the hat body, from hatOffset().
+     * @return True if the point is covered.
+     */
+    bool hitTest(float x, float y, float hatOffset) const;
+
+    /**
+     * @brief Gets the vertical shift of the hat body for a portrait of the given size, in unit space.
+     *
+     * @param size The portrait size.
+     * @return The shift, 0 for a size of 1.
+     */
+    static float hatOffset(float size) { return 0.05f - 0.05f / size; }
+
+private:
+    /**
+     * @brief Builds the features and their outlines.
+     */
+    PortraitPrototype();
+
+    /**
+     * @brief Appends an ellipse feature and tessellates it at every level of detail.
+     *
+     * @param xc X-coordinate of the center.
+     * @param yc Y-coordinate of the center.
+     * @param Semi_major Semi-axis along X.
+     * @param Semi_minor Semi-axis along Y.
+     * @param segments Number of segments at full detail.
+     * @param r Red color component.
+     * @param g Green color component.
+     * @param b Blue color component.
+     */
+    void addEllipse(float xc, float yc, float Semi_major, float Semi_minor, int segments, float r, float g, float b);
+
+    /**
+     * @brief Appends a rectangle feature.
+     *
+     * @param x0 Left edge.
+     * @param y0 Bottom edge.
+     * @param x1 Right edge.
+     * @param y1 Top edge.
+     * @param r Red color component.
+     * @param g Green color component.
+     * @param b Blue color component.
+     * @param hatBody True for the hat body.
+     */
+    void addRectangle(float x0, float y0, float x1, float y1, float r, float g, float b, bool hatBody = false);
+
+    /**
+     * @struct Level
+     * @brief A feature outline at one segment count.
+     */
+    struct Level {
+        int segments;                       /**< Segment count of the outline */
+        std::vector<OutlinePoint> outline;  /**< The tessellated outline */
+    };
+
+    /**
+     * @var features_
+     * @brief The features, back to front.
+     */
+    std::vector<PortraitFeature> features_;
+
+    /**
+     * @var levels_
+     * @brief Outlines of each feature, one per level of detail (a single one for rectangles).
+     */
+    std::vector<std::vector<Level>> levels_;
+};
+
+#endif // PORTRAITPROTOTYPE_H
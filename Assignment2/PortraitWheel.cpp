@@ -1,34 +1,84 @@
 #include "PortraitWheel.h"
-#include "portrait.h"
+#include "Portrait.h"
+#include <algorithm>
 #include <cmath>
 
 // constructor for the portraitwheel class
-PortraitWheel::PortraitWheel(WheelType type, WheelSize size, int num, float x, float y)
-    : ComplexGraphicObject2D(), wheelType(type), wheelSize(size), numPortraits(num) {
-    // Set the origin of the wheel
+PortraitWheel::PortraitWheel(WheelType type, WheelSize size, int num, float x, float y, SceneArena* arena)
+    : PortraitWheel(type, size, num, x, y, arena, portrait::reserveIds(num)) {
+}
+
+PortraitWheel::PortraitWheel(WheelType type, WheelSize size, int num, float x, float y, SceneArena* arena, unsigned int firstPortraitId)
+    : ComplexGraphicObject2D(arena ? arena->getResource() : std::pmr::get_default_resource()), wheelType(type), wheelSize(size), numPortraits(num) {
+    // Set the origin of the wheel, the portraits are placed relative to it
     setPosition(x, y);
 
     // Initialize the portraits based on the type, size, and number of heads
-    initializePortraits(type, size, num, x, y);
+    initializePortraits(type, size, num, arena, firstPortraitId);
+}
+
+std::vector<PortraitWheel*> PortraitWheel::createMany(const std::vector<WheelSpec>& specs, SceneArena& arena, ThreadPool& pool) {
+    std::vector<PortraitWheel*> wheels(specs.size());
+    if (specs.empty()) {
+        return wheels;
+    }
+
+    // One reservation for the whole batch, split into the ranges serial construction would have used
+    std::vector<unsigned int> firstIds(specs.size());
+    unsigned int total = 0;
+    for (size_t i = 0; i < specs.size(); i++) {
+        firstIds[i] = total;
+        total += static_cast<unsigned int>(specs[i].numPortraits);
+    }
+    unsigned int base = portrait::reserveIds(total);
+
+    // A few chunks per thread for load balancing, each with a private arena owned by the shared one
+    size_t chunkCount = std::min<size_t>(specs.size(), pool.getThreadCount() * 4);
+    size_t chunkSize = (specs.size() + chunkCount - 1) / chunkCount;
+    chunkCount = (specs.size() + chunkSize - 1) / chunkSize;
+    std::vector<SceneArena*> chunkArenas(chunkCount);
+    for (SceneArena*& chunkArena : chunkArenas) {
+        chunkArena = arena.create<SceneArena>();
+    }
+
+    pool.parallelFor(chunkCount, [&](size_t chunk) {
+        size_t end = std::min(specs.size(), (chunk + 1) * chunkSize);
+        for (size_t i = chunk * chunkSize; i < end; i++) {
+            const WheelSpec& spec = specs[i];
+            wheels[i] = chunkArenas[chunk]->create<PortraitWheel>(spec.type, spec.size, spec.numPortraits, spec.x, spec.y,
+                                                                  chunkArenas[chunk], base + firstIds[i]);
+            wheels[i]->setOrientation(spec.orientation);
+        }
+    });
+    return wheels;
 }
 
-void PortraitWheel::initializePortraits(WheelType type, WheelSize size, int num, float x, float y) {
+void PortraitWheel::initializePortraits(WheelType type, WheelSize size, int num, SceneArena* arena, unsigned int firstPortraitId) {
     float scale = getScaleFromSize(size); // calls wheelsize enum to get the floating point size of the scale
     float baseRadius = 4.0f; // sets the base size of the wheel so its not the same size as the portraits
 
     // Increase the radius according to the size of the wheel
     float radius = baseRadius * scale; // calculates the radius of the wheel
     float angleIncrement = 360.0f / num; // for the whole circle divide it up acording to the number of heads needed
+    reserveParts(num); // one part table allocation, placed before the portraits when using an arena
 
     // caculate the position for each of the portraits
     for (int i = 0; i < num; ++i) {
         float angle = i * angleIncrement;
         float radian = angle * (3.1415926f / 180.0f);
-        float portraitX = x + cos(radian) * radius;
-        float portraitY = y + sin(radian) * radius;
+        float portraitX = cos(radian) * radius; // relative to the wheel's center
+        float portraitY = sin(radian) * radius;
 
-        // Create a new portrait object and add it directly to the ComplexGraphicObject2D parts list
-        std::shared_ptr<portrait> portraitObject = std::make_shared<portrait>(portraitX, portraitY, scale, angle);
+        // Create a new portrait object, next to the wheel's other parts when an arena is given
+        std::shared_ptr<portrait> ownedPortrait;
+        portrait* portraitObject;
+        if (arena) {
+            portraitObject = arena->create<portrait>(portraitX, portraitY, scale, angle, firstPortraitId + i);
+        }
+        else {
+            ownedPortrait = std::make_shared<portrait>(portraitX, portraitY, scale, angle, firstPortraitId + i);
+            portraitObject = ownedPortrait.get();
+        }
         portraitObject->setPosition(portraitX, portraitY);
 
         // Adjust the orientation based on the wheel type
@@ -39,11 +89,35 @@ void PortraitWheel::initializePortraits(WheelType type, WheelSize size, int num,
             portraitObject->setOrientation(0); // All faces point upright
         }
 
-        // Add the portrait to the ComplexGraphicObject2D's parts list
-        addPart(portraitObject);
+        // Add the portrait to the ComplexGraphicObject2D's parts list. Heads on sticks turn with
+        // the wheel, heads on a wheel stay upright while it rotates
+        bool inheritOrientation = type == WheelType::HEADS_ON_STICKS;
+        if (ownedPortrait) {
+            addPart(ownedPortrait, inheritOrientation);
+        }
+        else {
+            addPart(portraitObject, inheritOrientation);
+        }
     }
 }
 
+WheelRecord PortraitWheel::toRecord() const {
+    return { getPositionX(), getPositionY(), getOrientation(),
+             static_cast<uint8_t>(wheelType), static_cast<uint8_t>(wheelSize), static_cast<uint8_t>(numPortraits), 0 };
+}
+
+// Files may come from anywhere, so out-of-range fields fall back to the interactive defaults
+WheelSpec PortraitWheel::specFromRecord(const WheelRecord& record) {
+    WheelType type = record.type <= static_cast<uint8_t>(WheelType::HEADS_ON_WHEEL) ? static_cast<WheelType>(record.type) : WheelType::HEADS_ON_WHEEL;
+    WheelSize size = record.size <= static_cast<uint8_t>(WheelSize::SMALL) ? static_cast<WheelSize>(record.size) : WheelSize::MEDIUM;
+    int numPortraits = record.numPortraits > 0 ? record.numPortraits : 5;
+    return { type, size, numPortraits, record.x, record.y, record.orientation };
+}
+
+void PortraitWheel::update(float dt) {
+    setOrientation(getOrientation() + ROTATION_SPEED * dt);
+}
+
 float PortraitWheel::getScaleFromSize(WheelSize size) {
     switch (size) {
     case WheelSize::LARGE: return 1.5f; // Larger scale
@@ -2,8 +2,13 @@
 #define PORTRAITWHEEL_H
 
 #include "ComplexGraphicObject2D.h"
-#include "portrait.h"
+#include "Portrait.h"
+#include "SceneArena.h"
+#include "Animatable.h"
+#include "ThreadPool.h"
+#include "SceneFile.h"
 #include <memory>
+#include <vector>
 
 /**
  * @enum WheelType
@@ -33,6 +38,19 @@ enum class WheelSize {
     SMALL    /**< Small-sized wheel */
 };
 
+/**
+ * @struct WheelSpec
+ * @brief Parameters of one wheel for PortraitWheel::createMany().
+ */
+struct WheelSpec {
+    WheelType type;   /**< Arrangement of the portraits */
+    WheelSize size;   /**< Size of the wheel */
+    int numPortraits; /**< Number of portraits on the wheel */
+    float x;          /**< X-coordinate of the wheel's center */
+    float y;          /**< Y-coordinate of the wheel's center */
+    float orientation = 0.0f; /**< Rotation of the wheel in degrees */
+};
+
 /**
  * @class PortraitWheel
  * @brief A complex graphic object representing a wheel of portraits.
@@ -45,11 +63,17 @@ enum class WheelSize {
  *
  * @see ComplexGraphicObject2D
  * @see portrait
+ * @see Animatable
  *
  * @author Harrison Grenier
  */
-class PortraitWheel : public ComplexGraphicObject2D {
+class PortraitWheel : public ComplexGraphicObject2D, public Animatable {
 public:
+    /**
+     * @brief Rotation speed of a spinning wheel in degrees per second (1 degree per 16 ms tick).
+     */
+    static constexpr float ROTATION_SPEED = 62.5f;
+
     /**
      * @brief Constructs a PortraitWheel object with specified type, size, and number of portraits.
      *
@@ -58,20 +82,76 @@ public:
      * @param num The number of portraits on the wheel.
      * @param x The X-coordinate of the wheel's center.
      * @param y The Y-coordinate of the wheel's center.
+     * @param arena If given, the portraits and the part table are allocated in it right after the
+     *        wheel (create the wheel itself with arena->create); otherwise they go on the heap.
+     */
+    PortraitWheel(WheelType type, WheelSize size, int num, float x, float y, SceneArena* arena = nullptr);
+
+    /**
+     * @brief Constructs a PortraitWheel whose portraits take the indices firstPortraitId, firstPortraitId + 1, ...
+     *
+     * @param type The type of portrait wheel.
+     * @param size The size of the wheel.
+     * @param num The number of portraits on the wheel.
+     * @param x The X-coordinate of the wheel's center.
+     * @param y The Y-coordinate of the wheel's center.
+     * @param arena Arena for the portraits and part table, or nullptr for the heap.
+     * @param firstPortraitId First index of a range of num indices reserved with portrait::reserveIds().
+     */
+    PortraitWheel(WheelType type, WheelSize size, int num, float x, float y, SceneArena* arena, unsigned int firstPortraitId);
+
+    /**
+     * @brief Builds many wheels at once, spread over a thread pool.
+     *
+     * The wheels are built in chunks, each into its own arena created inside the given one, so
+     * the threads never share an allocator. Portrait indices are reserved up front and handed
+     * out in spec order, so the result is the same as building the wheels one after the other.
+     *
+     * @param specs The wheels to build.
+     * @param arena Arena that ends up owning every wheel and portrait.
+     * @param pool Threads to build on.
+     * @return The wheels, in the order of specs.
+     */
+    static std::vector<PortraitWheel*> createMany(const std::vector<WheelSpec>& specs, SceneArena& arena, ThreadPool& pool);
+
+    /**
+     * @brief Describes the wheel for a scene file.
+     *
+     * @return The wheel's type, size, portrait count, position and orientation.
+     */
+    WheelRecord toRecord() const;
+
+    /**
+     * @brief Turns a stored wheel back into the parameters to build it with.
+     *
+     * Invalid types, sizes and portrait counts are replaced with the interactive defaults.
+     *
+     * @param record The stored wheel.
+     * @return The spec for createMany().
      */
-    PortraitWheel(WheelType type, WheelSize size, int num, float x, float y);
+    static WheelSpec specFromRecord(const WheelRecord& record);
+
+    /**
+     * @brief Spins the wheel counterclockwise at ROTATION_SPEED.
+     *
+     * @param dt Elapsed time in seconds.
+     */
+    void update(float dt) override;
 
 private:
     /**
      * @brief Initializes the portraits in the wheel based on the specified type, size, and number.
      *
+     * Portraits are placed relative to the wheel's center, so the wheel's own position,
+     * orientation and scale move all of them at once.
+     *
      * @param type The type of portrait wheel (orientation of the portraits).
      * @param size The size of the wheel (scaling factor for the portraits).
      * @param num The number of portraits to arrange on the wheel.
-     * @param x The X-coordinate of the wheel's center.
-     * @param y The Y-coordinate of the wheel's center.
+     * @param arena Arena to create the portraits in, or nullptr to allocate them on the heap.
+     * @param firstPortraitId Index of the first portrait; the others follow in order.
      */
-    void initializePortraits(WheelType type, WheelSize size, int num, float x, float y);
+    void initializePortraits(WheelType type, WheelSize size, int num, SceneArena* arena, unsigned int firstPortraitId);
 
     /**
      * @brief Returns the scale factor based on the selected wheel size.
@@ -0,0 +1,134 @@
+#ifndef RECORDINGRENDERCONTEXT_H
+#define RECORDINGRENDERCONTEXT_H
+
+#include "RenderContext.h"
+#include <vector>
+#include <cstddef>
+
+/**
+ * @enum RenderOp
+ * @brief The operation stored in a RenderCommand, one per RenderContext method.
+ */
+enum class RenderOp : unsigned char {
+    SET_COLOR,   /**< args: r, g, b */
+    BEGIN,       /**< args: primitive type */
+    VERTEX,      /**< args: x, y */
+    END,         /**< no args */
+    PUSH_MATRIX, /**< no args */
+    POP_MATRIX,  /**< no args */
+    TRANSLATE,   /**< args: x, y */
+    ROTATE,      /**< args: angle */
+    SCALE,       /**< args: sx, sy */
+    MULT_MATRIX  /**< args: a, b, c, d, tx, ty */
+};
+
+/**
+ * @struct RenderCommand
+ * @brief One recorded RenderContext call, stored by value in a flat buffer.
+ */
+struct RenderCommand {
+    RenderOp op;   /**< Which call was made */
+    float args[6]; /**< Its arguments, unused slots are zero */
+};
+
+/**
+ * @class RecordingRenderContext
+ * @brief RenderContext backend that captures every call into a flat command buffer.
+ *
+ * Drawing a scene into this backend costs only the scene traversal plus appending to a vector,
+ * so it isolates the CPU-side cost of draw(). The captured frame can then be inspected, counted,
+ * or replayed into any other backend.
+ *
+ * @see RenderContext
+ *
+ * @author Harrison Grenier
+ */
+class RecordingRenderContext : public RenderContext {
+public:
+    /** @brief Records a SET_COLOR command. */
+    void setColor(float r, float g, float b) override;
+    /** @brief Records a BEGIN command. */
+    void begin(PrimitiveType type) override;
+    /** @brief Records a VERTEX command. */
+    void vertex(float x, float y) override;
+    /** @brief Records an END command. */
+    void end() override;
+    /** @brief Records a PUSH_MATRIX command. */
+    void pushMatrix() override;
+    /** @brief Records a POP_MATRIX command. */
+    void popMatrix() override;
+    /** @brief Records a TRANSLATE command. */
+    void translate(float x, float y) override;
+    /** @brief Records a ROTATE command. */
+    void rotate(float angle) override;
+    /** @brief Records a SCALE command. */
+    void scale(float sx, float sy) override;
+    /** @brief Records a MULT_MATRIX command. */
+    void multMatrix(const Affine2D& m) override;
+
+    /**
+     * @brief Discards the recorded commands but keeps the buffer's memory for the next frame.
+     */
+    void clear();
+
+    /**
+     * @brief Replays the recorded commands, in order, into another context.
+     *
+     * @param target The context to replay into.
+     */
+    void replay(RenderContext& target) const;
+
+    /**
+     * @brief Gets the recorded commands.
+     *
+     * @return The flat command buffer.
+     */
+    const std::vector<RenderCommand>& getCommands() const { return commands_; }
+
+    /**
+     * @brief Gets the number of vertices recorded since the last clear().
+     *
+     * @return The vertex count.
+     */
+    size_t getVertexCount() const { return vertexCount_; }
+
+    /**
+     * @brief Gets the number of primitives (begin/end pairs) recorded since the last clear().
+     *
+     * @return The primitive count.
+     */
+    size_t getPrimitiveCount() const { return primitiveCount_; }
+
+private:
+    /**
+     * @brief Appends a command to the buffer.
+     *
+     * @param op The operation.
+     * @param a First argument.
+     * @param b Second argument.
+     * @param c Third argument.
+     */
+    void record(RenderOp op, float a = 0.0f, float b = 0.0f, float c = 0.0f) {
+        commands_.push_back({ op, { a, b, c, 0.0f, 0.0f, 0.0f } });
+    }
+
+    /**
+     * @var commands_
+     * @brief The recorded calls, in order.
+     */
+    std::vector<RenderCommand> commands_;
+
+    /**
+     * @var vertexCount_
+     * @brief Number of recorded vertices.
+     */
+    size_t vertexCount_ = 0;
+
+    /**
+     * @var primitiveCount_
+     * @brief Number of recorded primitives.
+     */
+    size_t primitiveCount_ = 0;
+};
+
+#endif // RECORDINGRENDERCONTEXT_H
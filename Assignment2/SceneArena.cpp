@@ -0,0 +1,20 @@
+#include "SceneArena.h"
+
+SceneArena::SceneArena(size_t blockSize) : resource_(blockSize), objectCount_(0) {
+}
+
+SceneArena::~SceneArena() {
+    release();
+}
+
+void SceneArena::release() {
+    // Newest first, so objects are destroyed before anything created ahead of them
+    for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+        it->destroy(it->object);
+    }
+    destructors_.clear();
+    objectCount_ = 0;
+
+    // Hands every block back to the heap at once
+    resource_.release();
+}
@@ -0,0 +1,112 @@
+#ifndef SCENEARENA_H
+#define SCENEARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SceneArena
+ * @brief Bump allocator that owns the objects of a scene and frees them all at once.
+ *
+ * Objects are constructed back to back in large blocks, so a wheel, its part table and its
+ * portraits end up next to each other in memory and creating them costs no per-object heap
+ * allocation. The pointers returned by create() are stable, non-owning handles: nothing is moved
+ * or freed until release() (or the arena's destructor) tears down the whole scene.
+ *
+ * getResource() exposes the same memory to containers, e.g. the part table of a
+ * ComplexGraphicObject2D, so their storage lives in the arena too.
+ *
+ * @note Objects can't be freed one by one; a removed object keeps its memory until release().
+ *
+ * @author Harrison Grenier
+ */
+class SceneArena {
+public:
+    /**
+     * @brief Constructs an empty arena.
+     *
+     * @param blockSize Size in bytes of the first block; later blocks grow geometrically.
+     */
+    explicit SceneArena(size_t blockSize = 64 * 1024);
+
+    /**
+     * @brief Destroys every object created in the arena and returns its memory.
+     */
+    ~SceneArena();
+
+    SceneArena(const SceneArena&) = delete;
+    SceneArena& operator=(const SceneArena&) = delete;
+
+    /**
+     * @brief Constructs an object in the arena.
+     *
+     * @tparam T Type of the object.
+     * @param args Arguments forwarded to T's constructor.
+     * @return A handle to the object, valid until release().
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        void* memory = resource_.allocate(sizeof(T), alignof(T));
+        T* object = new (memory) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors_.push_back({ object, [](void* p) { static_cast<T*>(p)->~T(); } });
+        }
+        objectCount_++;
+        return object;
+    }
+
+    /**
+     * @brief Gets the memory resource backing the arena, for containers that should live in it.
+     *
+     * @return The arena's memory resource.
+     */
+    std::pmr::memory_resource* getResource() { return &resource_; }
+
+    /**
+     * @brief Gets the number of objects created since the last release().
+     *
+     * @return The object count.
+     */
+    size_t getObjectCount() const { return objectCount_; }
+
+    /**
+     * @brief Destroys every object, newest first, and frees all blocks in one go.
+     *
+     * Every handle returned by create() becomes invalid.
+     */
+    void release();
+
+private:
+    /**
+     * @struct Destructor
+     * @brief An object that needs its destructor run by release().
+     */
+    struct Destructor {
+        void* object;           /**< The object to destroy */
+        void (*destroy)(void*); /**< Calls the object's destructor */
+    };
+
+    /**
+     * @var resource_
+     * @brief Monotonic block allocator all objects are carved from.
+     */
+    std::pmr::monotonic_buffer_resource resource_;
+
+    /**
+     * @var destructors_
+     * @brief Objects with non-trivial destructors, in creation order.
+     */
+    std::vector<Destructor> destructors_;
+
+    /**
+     * @var objectCount_
+     * @brief Number of objects created since the last release().
+     */
+    size_t objectCount_;
+};
+
+#endif // SCENEARENA_H
@@ -0,0 +1,194 @@
+#include "SceneFile.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char MAGIC[8] = { 'A', '2', 'S', 'C', 'E', 'N', 'E', '\0' };
+
+    // Fixed-size file header, followed by sectionCount SectionEntry
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t sectionCount;
+    };
+
+    struct SectionEntry {
+        uint32_t type;
+        uint32_t recordSize;
+        uint64_t offset;
+        uint64_t count;
+    };
+
+    uint64_t alignUp(uint64_t value) {
+        return (value + 7) & ~uint64_t(7);
+    }
+}
+
+bool SceneFile::write(const std::string& path, const std::vector<SectionData>& sections) {
+    FileHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.sectionCount = static_cast<uint32_t>(sections.size());
+
+    // Lay the record arrays out after the table, each 8-byte aligned
+    std::vector<SectionEntry> table;
+    uint64_t offset = alignUp(sizeof(FileHeader) + sections.size() * sizeof(SectionEntry));
+    for (const SectionData& section : sections) {
+        table.push_back({ static_cast<uint32_t>(section.type), section.recordSize, offset, section.count });
+        offset = alignUp(offset + section.recordSize * section.count);
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (!table.empty()) {
+        ok = ok && std::fwrite(table.data(), sizeof(SectionEntry), table.size(), file) == table.size();
+    }
+
+    const char padding[8] = {};
+    uint64_t written = sizeof(FileHeader) + table.size() * sizeof(SectionEntry);
+    for (size_t i = 0; i < sections.size() && ok; i++) {
+        ok = std::fwrite(padding, 1, table[i].offset - written, file) == table[i].offset - written;
+        uint64_t bytes = sections[i].recordSize * sections[i].count;
+        if (bytes > 0) {
+            ok = ok && std::fwrite(sections[i].records, 1, bytes, file) == bytes;
+        }
+        written = table[i].offset + bytes;
+    }
+    ok = std::fclose(file) == 0 && ok;
+    return ok;
+}
+
+SceneFile::SceneFile() : data_(nullptr), size_(0), mapping_(nullptr) {
+}
+
+SceneFile::~SceneFile() {
+    close();
+}
+
+bool SceneFile::open(const std::string& path) {
+    close();
+    error_.clear();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return fail("cannot open " + path);
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return fail("cannot map empty file " + path);
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);  // the mapping keeps the file open
+    if (!mapping) {
+        return fail("cannot map " + path);
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        return fail("cannot map " + path);
+    }
+    mapping_ = mapping;
+    data_ = static_cast<const unsigned char*>(view);
+    size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        return fail("cannot open " + path);
+    }
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0) {
+        ::close(file);
+        return fail("cannot map empty file " + path);
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);  // the mapping keeps the file open
+    if (view == MAP_FAILED) {
+        return fail("cannot map " + path);
+    }
+    data_ = static_cast<const unsigned char*>(view);
+    size_ = static_cast<size_t>(info.st_size);
+#endif
+
+    // Validate everything getSection() relies on, so lookups need no further checks
+    if (size_ < sizeof(FileHeader)) {
+        return fail(path + " is too short to be a scene file");
+    }
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(data_);
+    if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return fail(path + " is not a scene file");
+    }
+    if (header->version == 0 || header->version > VERSION) {
+        return fail(path + " has unsupported version " + std::to_string(header->version));
+    }
+    uint64_t tableEnd = sizeof(FileHeader) + uint64_t(header->sectionCount) * sizeof(SectionEntry);
+    if (tableEnd > size_) {
+        return fail(path + " has a truncated section table");
+    }
+    const SectionEntry* table = reinterpret_cast<const SectionEntry*>(header + 1);
+    for (uint32_t i = 0; i < header->sectionCount; i++) {
+        const SectionEntry& entry = table[i];
+        bool inside = entry.offset >= tableEnd && entry.offset % 8 == 0 && entry.offset <= size_ &&
+            (entry.recordSize == 0 || entry.count <= (size_ - entry.offset) / entry.recordSize);
+        if (!inside) {
+            return fail(path + " has a section outside the file");
+        }
+    }
+    return true;
+}
+
+void SceneFile::close() {
+    if (!data_) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(static_cast<HANDLE>(mapping_));
+#else
+    munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapping_ = nullptr;
+}
+
+uint32_t SceneFile::getVersion() const {
+    return data_ ? reinterpret_cast<const FileHeader*>(data_)->version : 0;
+}
+
+const void* SceneFile::findSection(SceneSectionType type, size_t recordSize, size_t& count) const {
+    count = 0;
+    if (!data_) {
+        return nullptr;
+    }
+    const FileHeader* header = reinterpret_cast<const FileHeader*>(data_);
+    const SectionEntry* table = reinterpret_cast<const SectionEntry*>(header + 1);
+    for (uint32_t i = 0; i < header->sectionCount; i++) {
+        if (table[i].type == static_cast<uint32_t>(type) && table[i].recordSize == recordSize) {
+            count = static_cast<size_t>(table[i].count);
+            return count > 0 ? data_ + table[i].offset : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+bool SceneFile::fail(const std::string& message) {
+    close();
+    error_ = message;
+    return false;
+}
@@ -0,0 +1,190 @@
+#ifndef SOFTWARERASTERIZER_H
+#define SOFTWARERASTERIZER_H
+
+#include "GeometryRenderContext.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class SoftwareRasterizer
+ * @brief Multithreaded, tile-based CPU renderer that needs neither a GPU nor a display.
+ *
+ * Scene objects draw into it like into any other RenderContext. The triangles and line segments
+ * of a frame are collected in screen space; endFrame() then bins them into square tiles and fills
+ * the tiles in parallel on a ThreadPool. Every tile draws its triangles in submission order, so
+ * overlapping shapes come out exactly as with the painter's-order OpenGL path, and tiles never
+ * share pixels so no locking is needed while rasterizing.
+ *
+ * The finished frame can be written as a binary PPM or an (uncompressed) PNG.
+ *
+ * @see GeometryRenderContext
+ * @see ThreadPool
+ *
+ * @author Harrison Grenier
+ */
+class SoftwareRasterizer : public GeometryRenderContext {
+public:
+    /**
+     * @brief Constructs a rasterizer for an image of the given size and world-space view.
+     *
+     * @param width Image width in pixels.
+     * @param height Image height in pixels.
+     * @param xMin World X-coordinate of the left image edge.
+     * @param xMax World X-coordinate of the right image edge.
+     * @param yMin World Y-coordinate of the bottom image edge.
+     * @param yMax World Y-coordinate of the top image edge.
+     * @param threadCount Number of threads to rasterize with. 0 uses one per core.
+     */
+    SoftwareRasterizer(int width, int height, float xMin, float xMax, float yMin, float yMax,
+                       unsigned int threadCount = 0);
+
+    /**
+     * @brief Starts a new frame: discards the previous geometry and sets the clear color.
+     *
+     * @param r Red component of the background.
+     * @param g Green component of the background.
+     * @param b Blue component of the background.
+     */
+    void beginFrame(float r = 0.0f, float g = 0.0f, float b = 0.0f);
+
+    /**
+     * @brief Bins the frame's geometry into tiles and rasterizes all tiles in parallel.
+     */
+    void endFrame();
+
+    /**
+     * @brief Gets the pixels of the last finished frame.
+     *
+     * @return Tightly packed 8-bit RGB rows, top row first.
+     */
+    const std::vector<uint8_t>& getPixels() const { return pixels_; }
+
+    /**
+     * @brief Gets the number of triangles submitted in the current frame.
+     *
+     * @return The triangle count (line segments count as two triangles).
+     */
+    size_t getTriangleCount() const { return triangles_.size(); }
+
+    /**
+     * @brief Gets the number of threads used for binning and rasterizing.
+     *
+     * @return The thread count.
+     */
+    unsigned int getThreadCount() const { return pool_.getThreadCount(); }
+
+    /**
+     * @brief Writes the last frame as a binary PPM (P6) image.
+     *
+     * @param path File to write.
+     * @return True on success.
+     */
+    bool writePPM(const std::string& path) const;
+
+    /**
+     * @brief Writes the last frame as a PNG image (stored, not compressed).
+     *
+     * @param path File to write.
+     * @return True on success.
+     */
+    bool writePNG(const std::string& path) const;
+
+    /**
+     * @brief Writes the last frame as PNG if the path ends in ".png", otherwise as PPM.
+     *
+     * @param path File to write.
+     * @return True on success.
+     */
+    bool writeImage(const std::string& path) const;
+
+    /**
+     * @brief Builds the file name of one frame from a pattern such as "frame_%04d.png".
+     *
+     * The pattern is not used as a printf format: it must hold exactly one %d, optionally with a
+     * width ("%4d") or zero padding ("%04d"), and "%%" for a literal percent sign.
+     *
+     * @param pattern Output pattern, usually taken from the command line.
+     * @param frame Frame number to substitute.
+     * @param path Receives the file name.
+     * @return False if the pattern has no conversion, more than one, or any other directive.
+     */
+    static bool formatFramePath(const std::string& pattern, int frame, std::string& path);
+
+protected:
+    /** @brief Maps the triangle to pixel coordinates and queues it for this frame. */
+    void emitTriangle(const GeometryVertex& a, const GeometryVertex& b, const GeometryVertex& c,
+                      const GeometryColor& color) override;
+    /** @brief Expands the segment into a one-pixel-wide quad and queues it for this frame. */
+    void emitLine(const GeometryVertex& a, const GeometryVertex& b, const GeometryColor& color) override;
+
+private:
+    /**
+     * @struct ScreenTriangle
+     * @brief A triangle in pixel coordinates with its packed color and pixel bounds.
+     */
+    struct ScreenTriangle {
+        float x[3], y[3];       /**< Vertices in pixels, y pointing down */
+        int minX, minY;         /**< First pixel column/row covered by the bounding box */
+        int maxX, maxY;         /**< Last pixel column/row covered by the bounding box */
+        uint8_t rgb[3];         /**< Fill color */
+    };
+
+    /**
+     * @brief Queues a triangle given in pixel coordinates.
+     */
+    void addScreenTriangle(float x0, float y0, float x1, float y1, float x2, float y2, const GeometryColor& color);
+
+    /**
+     * @brief Fills one tile with the triangles binned to it.
+     *
+     * @param tile Tile index.
+     */
+    void rasterizeTile(size_t tile);
+
+    /**
+     * @var TILE_SIZE
+     * @brief Width and height of a tile in pixels.
+     */
+    static const int TILE_SIZE = 64;
+
+    int width_;        /**< Image width in pixels */
+    int height_;       /**< Image height in pixels */
+    float xMin_;       /**< World X at the left edge */
+    float yMax_;       /**< World Y at the top edge */
+    float pixelsPerUnitX_; /**< Horizontal world-to-pixel scale */
+    float pixelsPerUnitY_; /**< Vertical world-to-pixel scale */
+    int tilesX_;       /**< Number of tile columns */
+    int tilesY_;       /**< Number of tile rows */
+    uint8_t clear_[3]; /**< Background color of the current frame */
+
+    /**
+     * @var triangles_
+     * @brief Triangles of the current frame, in submission order.
+     */
+    std::vector<ScreenTriangle> triangles_;
+
+    /**
+     * @var bins_
+     * @brief bins_[chunk][tile] lists, in order, the triangles of a submission chunk that touch a tile.
+     *
+     * Each thread bins one contiguous chunk of triangles, so concatenating the chunks of a tile
+     * restores submission order without any synchronization.
+     */
+    std::vector<std::vector<std::vector<uint32_t>>> bins_;
+
+    /**
+     * @var pixels_
+     * @brief The frame buffer, 8-bit RGB, top row first.
+     */
+    std::vector<uint8_t> pixels_;
+
+    /**
+     * @var pool_
+     * @brief Threads used for binning and rasterizing.
+     */
+    ThreadPool pool_;
+};
+
+#endif // SOFTWARERASTERIZER_H
@@ -0,0 +1,274 @@
+#include "SpatialGrid.h"
+#include "ComplexGraphicObject2D.h"
+#include "Portrait.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cellSize_(cellSize), nextOrder_(0), queryStamp_(0) {
+}
+
+void SpatialGrid::insert(GraphicObject2D* object) {
+    if (index_.count(object)) {
+        return;
+    }
+
+    uint32_t id;
+    if (freeEntries_.empty()) {
+        id = static_cast<uint32_t>(entries_.size());
+        entries_.emplace_back();
+    }
+    else {
+        id = freeEntries_.back();
+        freeEntries_.pop_back();
+    }
+
+    Entry& entry = entries_[id];
+    entry.object = object;
+    entry.bounds = sweptBounds(*object);
+    entry.order = nextOrder_++;
+    entry.stamp = queryStamp_;
+    computeCells(entry);
+    index_[object] = id;
+    link(id);
+}
+
+void SpatialGrid::remove(GraphicObject2D* object) {
+    auto found = index_.find(object);
+    if (found == index_.end()) {
+        return;
+    }
+
+    uint32_t id = found->second;
+    unlink(id);
+    entries_[id].object = nullptr;
+    freeEntries_.push_back(id);
+    index_.erase(found);
+}
+
+void SpatialGrid::update(GraphicObject2D* object) {
+    auto found = index_.find(object);
+    if (found == index_.end()) {
+        return;
+    }
+
+    uint32_t id = found->second;
+    Entry moved = entries_[id];
+    moved.bounds = sweptBounds(*object);
+    computeCells(moved);
+
+    // Only touch the grid if the object crossed into different cells
+    const Entry& old = entries_[id];
+    bool sameCells = old.bounds.isInfinite() == moved.bounds.isInfinite() &&
+        old.cellMinX == moved.cellMinX && old.cellMinY == moved.cellMinY &&
+        old.cellMaxX == moved.cellMaxX && old.cellMaxY == moved.cellMaxY;
+    if (sameCells) {
+        entries_[id].bounds = moved.bounds;
+        return;
+    }
+
+    unlink(id);
+    entries_[id] = moved;
+    link(id);
+}
+
+void SpatialGrid::clear() {
+    entries_.clear();
+    freeEntries_.clear();
+    index_.clear();
+    cells_.clear();
+    unbounded_.clear();
+    nextOrder_ = 0;
+}
+
+std::vector<GraphicObject2D*> SpatialGrid::queryPoint(float x, float y) const {
+    return collect({ x, y, x, y }, [x, y](const BoundingBox2D& bounds) {
+        return bounds.contains(x, y);
+    });
+}
+
+std::vector<GraphicObject2D*> SpatialGrid::queryRect(const BoundingBox2D& region) const {
+    return collect(region, [&region](const BoundingBox2D& bounds) {
+        return bounds.intersects(region);
+    });
+}
+
+std::vector<GraphicObject2D*> SpatialGrid::queryRadius(float x, float y, float radius) const {
+    float radiusSquared = radius * radius;
+    return collect({ x - radius, y - radius, x + radius, y + radius }, [=](const BoundingBox2D& bounds) {
+        if (bounds.isInfinite()) {
+            return true;
+        }
+        // Distance from the center to the closest point of the box
+        float dx = std::max({ bounds.minX - x, 0.0f, x - bounds.maxX });
+        float dy = std::max({ bounds.minY - y, 0.0f, y - bounds.maxY });
+        return dx * dx + dy * dy <= radiusSquared;
+    });
+}
+
+PortraitHit SpatialGrid::pickPortrait(float x, float y) const {
+    std::vector<GraphicObject2D*> candidates = queryPoint(x, y);
+
+    // Walk from the topmost object down; within a composite, later parts are drawn on top
+    for (auto it = candidates.rbegin(); it != candidates.rend(); ++it) {
+        GraphicObject2D* object = *it;
+        float localX, localY;
+
+        if (auto* composite = dynamic_cast<const ComplexGraphicObject2D*>(object)) {
+            for (size_t i = composite->getPartCount(); i-- > 0;) {
+                auto* face = dynamic_cast<const portrait*>(composite->getPart(i));
+                if (!face) {
+                    continue;
+                }
+
+                Affine2D toWorld = composite->getPartSpace(i) * face->getTransform();
+                toWorld.inverse().apply(x, y, localX, localY);
+                if (face->hitTest(localX, localY)) {
+                    return { object, face };
+                }
+            }
+        }
+        else if (auto* face = dynamic_cast<const portrait*>(object)) {
+            face->getTransform().inverse().apply(x, y, localX, localY);
+            if (face->hitTest(localX, localY)) {
+                return { object, face };
+            }
+        }
+    }
+    return { nullptr, nullptr };
+}
+
+// A full turn around the position sweeps the local box into a circle through its farthest corner
+BoundingBox2D SpatialGrid::sweptBounds(const GraphicObject2D& object) {
+    BoundingBox2D local = object.getLocalBounds();
+    if (local.isInfinite() || local.isEmpty()) {
+        return local;
+    }
+
+    float reachX = std::max(std::abs(local.minX), std::abs(local.maxX));
+    float reachY = std::max(std::abs(local.minY), std::abs(local.maxY));
+    float radius = std::sqrt(reachX * reachX + reachY * reachY) * std::abs(object.getScale());
+    float x = object.getPositionX();
+    float y = object.getPositionY();
+    return { x - radius, y - radius, x + radius, y + radius };
+}
+
+void SpatialGrid::computeCells(Entry& entry) const {
+    if (entry.bounds.isInfinite() || entry.bounds.isEmpty()) {
+        entry.cellMinX = entry.cellMinY = 0;
+        entry.cellMaxX = entry.cellMaxY = -1;
+        return;
+    }
+    entry.cellMinX = cellIndex(entry.bounds.minX);
+    entry.cellMinY = cellIndex(entry.bounds.minY);
+    entry.cellMaxX = cellIndex(entry.bounds.maxX);
+    entry.cellMaxY = cellIndex(entry.bounds.maxY);
+}
+
+// Clamped while still floating point, so a coordinate far outside the int range never reaches the cast;
+// the margin left below INT_MAX lets the loops over a cell range step past their last cell
+int SpatialGrid::cellIndex(float coordinate) const {
+    const double limit = std::numeric_limits<int>::max() / 2;
+    double cell = std::floor(static_cast<double>(coordinate) / cellSize_);
+    return static_cast<int>(std::min(std::max(cell, -limit), limit));
+}
+
+void SpatialGrid::link(uint32_t id) {
+    const Entry& entry = entries_[id];
+    if (entry.bounds.isInfinite()) {
+        unbounded_.push_back(id);
+        return;
+    }
+    for (int cy = entry.cellMinY; cy <= entry.cellMaxY; ++cy) {
+        for (int cx = entry.cellMinX; cx <= entry.cellMaxX; ++cx) {
+            cells_[cellKey(cx, cy)].push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::unlink(uint32_t id) {
+    const Entry& entry = entries_[id];
+    if (entry.bounds.isInfinite()) {
+        unbounded_.erase(std::find(unbounded_.begin(), unbounded_.end(), id));
+        return;
+    }
+    for (int cy = entry.cellMinY; cy <= entry.cellMaxY; ++cy) {
+        for (int cx = entry.cellMinX; cx <= entry.cellMaxX; ++cx) {
+            auto cell = cells_.find(cellKey(cx, cy));
+            std::vector<uint32_t>& ids = cell->second;
+            // Order within a cell doesn't matter, so swap the entry out
+            *std::find(ids.begin(), ids.end(), id) = ids.back();
+            ids.pop_back();
+            if (ids.empty()) {
+                cells_.erase(cell);
+            }
+        }
+    }
+}
+
+template <typename Predicate>
+std::vector<GraphicObject2D*> SpatialGrid::collect(const BoundingBox2D& region, Predicate keep) const {
+    std::vector<uint32_t> found;
+    uint32_t stamp = ++queryStamp_;
+
+    auto visit = [&](uint32_t id) {
+        const Entry& entry = entries_[id];
+        if (entry.stamp == stamp) {
+            return;  // Already seen in another cell
+        }
+        entry.stamp = stamp;
+        if (keep(entry.bounds)) {
+            found.push_back(id);
+        }
+    };
+
+    for (uint32_t id : unbounded_) {
+        visit(id);
+    }
+
+    if (!region.isEmpty()) {
+        int minX = 0, minY = 0, maxX = -1, maxY = -1;
+        double regionCells = std::numeric_limits<double>::infinity();
+        if (!region.isInfinite()) {
+            minX = cellIndex(region.minX);
+            minY = cellIndex(region.minY);
+            maxX = cellIndex(region.maxX);
+            maxY = cellIndex(region.maxY);
+            regionCells = (static_cast<double>(maxX) - minX + 1) * (static_cast<double>(maxY) - minY + 1);
+        }
+
+        // A huge region covers more cells than exist, so walk the occupied cells instead
+        if (regionCells > static_cast<double>(cells_.size())) {
+            for (const auto& cell : cells_) {
+                for (uint32_t id : cell.second) {
+                    visit(id);
+                }
+            }
+        }
+        else {
+            for (int cy = minY; cy <= maxY; ++cy) {
+                for (int cx = minX; cx <= maxX; ++cx) {
+                    auto cell = cells_.find(cellKey(cx, cy));
+                    if (cell == cells_.end()) {
+                        continue;
+                    }
+                    for (uint32_t id : cell->second) {
+                        visit(id);
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(found.begin(), found.end(), [this](uint32_t a, uint32_t b) {
+        return entries_[a].order < entries_[b].order;
+    });
+
+    std::vector<GraphicObject2D*> objects;
+    objects.reserve(found.size());
+    for (uint32_t id : found) {
+        objects.push_back(entries_[id].object);
+    }
+    return objects;
+}
@@ -0,0 +1,242 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "GraphicObject2D.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class portrait;
+
+/**
+ * @struct PortraitHit
+ * @brief Result of a portrait pick: the portrait and the top-level object it belongs to.
+ */
+struct PortraitHit {
+    GraphicObject2D* object; /**< The indexed object that was hit (a wheel, or the portrait itself) */
+    const portrait* face;    /**< The portrait under the point, or nullptr if nothing was hit */
+};
+
+/**
+ * @class SpatialGrid
+ * @brief Uniform-grid index over the bounds of scene objects, for picking and region queries.
+ *
+ * Each object is filed under every grid cell its bounds overlap, so a query only looks at the
+ * objects in the cells it touches instead of scanning the whole scene. The bounds used are
+ * swept over a full turn of the object around its position, so rotating objects (such as
+ * spinning wheels) never need re-indexing; update() after a move only touches the grid when the
+ * object's cell range actually changed.
+ *
+ * Objects are ordered by insertion, which matches the drawing order, so query results come
+ * back bottom to top and picking returns the topmost hit.
+ *
+ * @note Objects with unknown (infinite) bounds are kept in a separate list and returned by every query.
+ *
+ * @author Harrison Grenier
+ */
+class SpatialGrid {
+public:
+    /**
+     * @brief Constructs an empty grid.
+     *
+     * @param cellSize Width and height of a cell in world units; about the size of a typical object.
+     */
+    explicit SpatialGrid(float cellSize = 2.0f);
+
+    /**
+     * @brief Adds an object on top of the ones already indexed.
+     *
+     * @param object The object to index; must stay alive until removed.
+     */
+    void insert(GraphicObject2D* object);
+
+    /**
+     * @brief Removes an object. Does nothing if it isn't indexed.
+     *
+     * @param object The object to remove.
+     */
+    void remove(GraphicObject2D* object);
+
+    /**
+     * @brief Refreshes an object's cells after it moved or was scaled.
+     *
+     * @param object The object that changed.
+     */
+    void update(GraphicObject2D* object);
+
+    /**
+     * @brief Removes every object.
+     */
+    void clear();
+
+    /**
+     * @brief Gets the number of indexed objects.
+     *
+     * @return The object count.
+     */
+    size_t size() const { return index_.size(); }
+
+    /**
+     * @brief Finds the objects whose bounds contain a point.
+     *
+     * @param x World X-coordinate of the point.
+     * @param y World Y-coordinate of the point.
+     * @return The objects, bottom to top.
+     */
+    std::vector<GraphicObject2D*> queryPoint(float x, float y) const;
+
+    /**
+     * @brief Finds the objects whose bounds overlap a rectangle.
+     *
+     * @param region The rectangle, in world space.
+     * @return The objects, bottom to top.
+     */
+    std::vector<GraphicObject2D*> queryRect(const BoundingBox2D& region) const;
+
+    /**
+     * @brief Finds the objects whose bounds come within a distance of a point.
+     *
+     * @param x World X-coordinate of the center.
+     * @param y World Y-coordinate of the center.
+     * @param radius Search radius.
+     * @return The objects, bottom to top.
+     */
+    std::vector<GraphicObject2D*> queryRadius(float x, float y, float radius) const;
+
+    /**
+     * @brief Finds the topmost portrait drawn under a point.
+     *
+     * Portraits are looked for at the top level and among the parts of indexed composites, and
+     * tested against their actual shape (face, ears and hat) rather than their bounds.
+     *
+     * @param x World X-coordinate of the point.
+     * @param y World Y-coordinate of the point.
+     * @return The hit, with a null face if no portrait is under the point.
+     */
+    PortraitHit pickPortrait(float x, float y) const;
+
+private:
+    /**
+     * @struct Entry
+     * @brief An indexed object and the cells it is filed under.
+     */
+    struct Entry {
+        GraphicObject2D* object; /**< The indexed object */
+        BoundingBox2D bounds;    /**< Its rotation-independent bounds when it was last indexed */
+        int cellMinX;            /**< First cell column covered */
+        int cellMinY;            /**< First cell row covered */
+        int cellMaxX;            /**< Last cell column covered */
+        int cellMaxY;            /**< Last cell row covered */
+        uint64_t order;          /**< Insertion sequence number, higher is drawn later */
+        mutable uint32_t stamp;  /**< Last query that collected the entry, to skip duplicates */
+    };
+
+    /**
+     * @brief Computes an object's bounds swept over a full turn around its position.
+     *
+     * @param object The object.
+     * @return The bounds, infinite if the object doesn't report any.
+     */
+    static BoundingBox2D sweptBounds(const GraphicObject2D& object);
+
+    /**
+     * @brief Files an entry under every cell of its cell range.
+     *
+     * @param id Index of the entry in entries_.
+     */
+    void link(uint32_t id);
+
+    /**
+     * @brief Removes an entry from every cell of its cell range.
+     *
+     * @param id Index of the entry in entries_.
+     */
+    void unlink(uint32_t id);
+
+    /**
+     * @brief Computes the cell range of an entry from its bounds.
+     *
+     * @param entry The entry to update.
+     */
+    void computeCells(Entry& entry) const;
+
+    /**
+     * @brief Gets the column or row of the cell a coordinate falls in.
+     *
+     * @param coordinate A finite X- or Y-coordinate, in world space.
+     * @return The cell index, clamped to half the int range either way.
+     */
+    int cellIndex(float coordinate) const;
+
+    /**
+     * @brief Collects the entries filed under the cells a region overlaps, plus the unbounded ones.
+     *
+     * @param region The region, in world space.
+     * @param keep Predicate an entry's bounds must pass to be returned.
+     * @return The objects, bottom to top.
+     */
+    template <typename Predicate>
+    std::vector<GraphicObject2D*> collect(const BoundingBox2D& region, Predicate keep) const;
+
+    /**
+     * @brief Packs a cell's column and row into a hash key.
+     *
+     * @param cx Cell column.
+     * @param cy Cell row.
+     * @return The key.
+     */
+    static uint64_t cellKey(int cx, int cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    /**
+     * @var cellSize_
+     * @brief Width and height of a cell.
+     */
+    float cellSize_;
+
+    /**
+     * @var entries_
+     * @brief Storage for the entries; freed slots are reused.
+     */
+    std::vector<Entry> entries_;
+
+    /**
+     * @var freeEntries_
+     * @brief Indices of unused slots in entries_.
+     */
+    std::vector<uint32_t> freeEntries_;
+
+    /**
+     * @var index_
+     * @brief Entry of every indexed object.
+     */
+    std::unordered_map<GraphicObject2D*, uint32_t> index_;
+
+    /**
+     * @var cells_
+     * @brief Entries filed under each non-empty cell.
+     */
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells_;
+
+    /**
+     * @var unbounded_
+     * @brief Entries with infinite bounds, which no cell can hold.
+     */
+    std::vector<uint32_t> unbounded_;
+
+    /**
+     * @var nextOrder_
+     * @brief Sequence number given to the next inserted object.
+     */
+    uint64_t nextOrder_;
+
+    /**
+     * @var queryStamp_
+     * @brief Incremented by every query, to recognize entries already collected.
+     */
+    mutable uint32_t queryStamp_;
+};
+
+#endif // SPATIALGRID_H
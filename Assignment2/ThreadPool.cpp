@@ -0,0 +1,85 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+    : task_(nullptr), count_(0), next_(0), generation_(0), busyWorkers_(0), stopping_(false) {
+    if (threadCount == 0) {
+        threadCount = std::thread::hardware_concurrency();
+    }
+    if (threadCount == 0) {
+        threadCount = 1;  // hardware_concurrency may not know
+    }
+
+    // The thread calling parallelFor works too, so start one less
+    for (unsigned int i = 1; i < threadCount; i++) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+    if (workers_.empty() || count == 1) {
+        for (size_t i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+
+    // Publish the job and wake the workers
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        count_ = count;
+        next_.store(0);
+        busyWorkers_ = static_cast<unsigned int>(workers_.size());
+        generation_++;
+    }
+    wake_.notify_all();
+
+    runCurrentJob();
+
+    // Wait for the workers to drain their last indices
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return busyWorkers_ == 0; });
+    task_ = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    unsigned long seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seenGeneration; });
+            if (stopping_) {
+                return;
+            }
+            seenGeneration = generation_;
+        }
+
+        runCurrentJob();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busyWorkers_--;
+        }
+        done_.notify_one();
+    }
+}
+
+void ThreadPool::runCurrentJob() {
+    for (size_t i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1)) {
+        (*task_)(i);
+    }
+}
@@ -0,0 +1,128 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief A fixed set of worker threads that run data-parallel loops.
+ *
+ * The pool only supports one kind of job: parallelFor, which runs a task for every index in
+ * [0, count) and returns once all of them are done. Indices are handed out from a shared atomic
+ * counter so fast threads pick up the slack of slow ones, and the calling thread works too.
+ *
+ * @note parallelFor must not be called from inside one of its own tasks.
+ *
+ * @author Harrison Grenier
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the worker threads.
+     *
+     * @param threadCount Total number of threads to use, including the caller. 0 uses one per core.
+     */
+    explicit ThreadPool(unsigned int threadCount = 0);
+
+    /**
+     * @brief Stops and joins the worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Runs task(i) for every i in [0, count) across all threads and waits for completion.
+     *
+     * @param count Number of indices to process.
+     * @param task The work to run for each index.
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+    /**
+     * @brief Gets the number of threads that take part in parallelFor, including the caller.
+     *
+     * @return The thread count.
+     */
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(workers_.size()) + 1; }
+
+private:
+    /**
+     * @brief Main loop of each worker thread.
+     */
+    void workerLoop();
+
+    /**
+     * @brief Pulls indices from the current job until none are left.
+     */
+    void runCurrentJob();
+
+    /**
+     * @var workers_
+     * @brief The worker threads (the caller of parallelFor is the extra one).
+     */
+    std::vector<std::thread> workers_;
+
+    /**
+     * @var mutex_
+     * @brief Guards the job hand-off between parallelFor and the workers.
+     */
+    std::mutex mutex_;
+
+    /**
+     * @var wake_
+     * @brief Signals the workers that a new job is available or that the pool is stopping.
+     */
+    std::condition_variable wake_;
+
+    /**
+     * @var done_
+     * @brief Signals parallelFor that every worker has finished the current job.
+     */
+    std::condition_variable done_;
+
+    /**
+     * @var task_
+     * @brief The task of the current job.
+     */
+    const std::function<void(size_t)>* task_;
+
+    /**
+     * @var count_
+     * @brief Number of indices in the current job.
+     */
+    size_t count_;
+
+    /**
+     * @var next_
+     * @brief Next index of the current job to hand out.
+     */
+    std::atomic<size_t> next_;
+
+    /**
+     * @var generation_
+     * @brief Incremented for every job so sleeping workers can tell a new one arrived.
+     */
+    unsigned long generation_;
+
+    /**
+     * @var busyWorkers_
+     * @brief Number of workers still running the current job.
+     */
+    unsigned int busyWorkers_;
+
+    /**
+     * @var stopping_
+     * @brief Set by the destructor to make the workers exit.
+     */
+    bool stopping_;
+};
+
+#endif // THREADPOOL_H
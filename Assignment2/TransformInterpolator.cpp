@@ -0,0 +1,57 @@
+#include "TransformInterpolator.h"
+#include <algorithm>
+#include <cmath>
+
+void TransformInterpolator::track(GraphicObject2D* object) {
+    float x = object->getPositionX(), y = object->getPositionY(), angle = object->getOrientation();
+    entries_.push_back({ object, x, y, angle, x, y, angle });
+}
+
+void TransformInterpolator::untrack(GraphicObject2D* object) {
+    entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                  [object](const Entry& entry) { return entry.object == object; }),
+                   entries_.end());
+}
+
+void TransformInterpolator::clear() {
+    entries_.clear();
+    applied_ = false;
+}
+
+void TransformInterpolator::capture() {
+    for (Entry& entry : entries_) {
+        entry.previousX = entry.object->getPositionX();
+        entry.previousY = entry.object->getPositionY();
+        entry.previousAngle = entry.object->getOrientation();
+    }
+}
+
+void TransformInterpolator::apply(float alpha) {
+    for (Entry& entry : entries_) {
+        GraphicObject2D& object = *entry.object;
+        entry.currentX = object.getPositionX();
+        entry.currentY = object.getPositionY();
+        entry.currentAngle = object.getOrientation();
+
+        object.setPosition(entry.previousX + (entry.currentX - entry.previousX) * alpha,
+                           entry.previousY + (entry.currentY - entry.previousY) * alpha);
+
+        // Shorter way round; a flip is shown as it happens instead of as a half-turn spin
+        float turn = std::remainder(entry.currentAngle - entry.previousAngle, 360.0f);
+        if (std::abs(turn) <= 90.0f) {
+            object.setOrientation(entry.currentAngle - turn * (1.0f - alpha));
+        }
+    }
+    applied_ = true;
+}
+
+void TransformInterpolator::restore() {
+    if (!applied_) {
+        return;
+    }
+    for (const Entry& entry : entries_) {
+        entry.object->setPosition(entry.currentX, entry.currentY);
+        entry.object->setOrientation(entry.currentAngle);
+    }
+    applied_ = false;
+}
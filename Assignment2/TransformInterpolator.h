@@ -0,0 +1,91 @@
+#ifndef TRANSFORMINTERPOLATOR_H
+#define TRANSFORMINTERPOLATOR_H
+
+#include "GraphicObject2D.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class TransformInterpolator
+ * @brief Shows moving objects between two simulation steps without touching the simulation.
+ *
+ * capture() records the position and orientation of every tracked object before a step. When a
+ * frame is drawn, apply() moves each object to the blend of its captured and current state and
+ * restore() puts the simulated state back afterwards, so simulation code only ever sees whole steps.
+ *
+ * Orientations are blended along the shorter way round; a turn of more than 90 degrees within one
+ * step (such as a cart turning around) is shown as a jump rather than a spin.
+ *
+ * @see FixedTimestep
+ *
+ * @author Harrison Grenier
+ */
+class TransformInterpolator {
+public:
+    /**
+     * @brief Starts tracking an object. Its previous state is its current one.
+     *
+     * @param object The object to interpolate; must outlive the tracking.
+     */
+    void track(GraphicObject2D* object);
+
+    /**
+     * @brief Stops tracking an object. Does nothing if it isn't tracked.
+     *
+     * @param object The object to stop interpolating.
+     */
+    void untrack(GraphicObject2D* object);
+
+    /**
+     * @brief Stops tracking every object at once.
+     */
+    void clear();
+
+    /**
+     * @brief Records the current state of every tracked object as the state before the next step.
+     */
+    void capture();
+
+    /**
+     * @brief Moves every tracked object to the blend of its captured and current state.
+     *
+     * Must be followed by restore() before the simulation runs again.
+     *
+     * @param alpha 0 shows the captured state, 1 the current one.
+     */
+    void apply(float alpha);
+
+    /**
+     * @brief Puts back the state every tracked object had before apply().
+     */
+    void restore();
+
+private:
+    /**
+     * @struct Entry
+     * @brief A tracked object with its captured and simulated states.
+     */
+    struct Entry {
+        GraphicObject2D* object;  /**< The tracked object */
+        float previousX;          /**< X-coordinate before the last step */
+        float previousY;          /**< Y-coordinate before the last step */
+        float previousAngle;      /**< Orientation before the last step */
+        float currentX;           /**< Simulated X-coordinate, saved by apply() */
+        float currentY;           /**< Simulated Y-coordinate, saved by apply() */
+        float currentAngle;       /**< Simulated orientation, saved by apply() */
+    };
+
+    /**
+     * @var entries_
+     * @brief The tracked objects.
+     */
+    std::vector<Entry> entries_;
+
+    /**
+     * @var applied_
+     * @brief True between apply() and restore().
+     */
+    bool applied_ = false;
+};
+
+#endif // TRANSFORMINTERPOLATOR_H